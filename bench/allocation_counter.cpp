@@ -0,0 +1,186 @@
+/**
+ * @file allocation_counter.cpp
+ * @brief Replaces the global allocation functions with the counting ones.
+ */
+
+#include "allocation_counter.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h> // for _aligned_malloc
+#endif
+
+namespace {
+// Trivial type, so it is constant-initialized and usable from the very first allocation
+thread_local std::uint64_t allocations = 0;
+
+auto allocate(std::size_t size) noexcept -> void*
+{
+    ++allocations;
+    return std::malloc(size == 0 ? 1 : size); // NOLINT(*-no-malloc,*-owning-memory)
+}
+
+auto allocate(std::size_t size, std::align_val_t alignment) noexcept -> void*
+{
+    ++allocations;
+    const auto align = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+    return _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+    // std::aligned_alloc() requires the size to be a multiple of the alignment
+    return std::aligned_alloc(align, (size + align - 1) / align * align);
+#endif
+}
+
+auto deallocate(void* ptr) noexcept -> void
+{
+    std::free(ptr); // NOLINT(*-no-malloc,*-owning-memory)
+}
+
+auto deallocate(void* ptr, std::align_val_t /*unused*/) noexcept -> void
+{
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr); // NOLINT(*-no-malloc,*-owning-memory)
+#endif
+}
+
+template<typename... Args>
+auto allocate_or_throw(std::size_t size, Args... args) -> void*
+{
+    for (;;) {
+        if (auto* ptr = allocate(size, args...)) {
+            return ptr;
+        }
+        auto* handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+} // namespace
+
+namespace SlimLog::Bench {
+
+auto AllocationCounter::count() noexcept -> std::uint64_t
+{
+    return allocations;
+}
+
+} // namespace SlimLog::Bench
+
+// NOLINTBEGIN(*-new-delete-overloads)
+auto operator new(std::size_t size) -> void*
+{
+    return allocate_or_throw(size);
+}
+
+auto operator new[](std::size_t size) -> void*
+{
+    return allocate_or_throw(size);
+}
+
+auto operator new(std::size_t size, std::align_val_t alignment) -> void*
+{
+    return allocate_or_throw(size, alignment);
+}
+
+auto operator new[](std::size_t size, std::align_val_t alignment) -> void*
+{
+    return allocate_or_throw(size, alignment);
+}
+
+auto operator new(std::size_t size, const std::nothrow_t& /*unused*/) noexcept -> void*
+{
+    return allocate(size);
+}
+
+auto operator new[](std::size_t size, const std::nothrow_t& /*unused*/) noexcept -> void*
+{
+    return allocate(size);
+}
+
+auto operator new(
+    std::size_t size, std::align_val_t alignment, const std::nothrow_t& /*unused*/) noexcept
+    -> void*
+{
+    return allocate(size, alignment);
+}
+
+auto operator new[](
+    std::size_t size, std::align_val_t alignment, const std::nothrow_t& /*unused*/) noexcept
+    -> void*
+{
+    return allocate(size, alignment);
+}
+
+auto operator delete(void* ptr) noexcept -> void
+{
+    deallocate(ptr);
+}
+
+auto operator delete[](void* ptr) noexcept -> void
+{
+    deallocate(ptr);
+}
+
+auto operator delete(void* ptr, std::size_t /*unused*/) noexcept -> void
+{
+    deallocate(ptr);
+}
+
+auto operator delete[](void* ptr, std::size_t /*unused*/) noexcept -> void
+{
+    deallocate(ptr);
+}
+
+auto operator delete(void* ptr, std::align_val_t alignment) noexcept -> void
+{
+    deallocate(ptr, alignment);
+}
+
+auto operator delete[](void* ptr, std::align_val_t alignment) noexcept -> void
+{
+    deallocate(ptr, alignment);
+}
+
+auto operator delete(void* ptr, std::size_t /*unused*/, std::align_val_t alignment) noexcept
+    -> void
+{
+    deallocate(ptr, alignment);
+}
+
+auto operator delete[](void* ptr, std::size_t /*unused*/, std::align_val_t alignment) noexcept
+    -> void
+{
+    deallocate(ptr, alignment);
+}
+
+auto operator delete(void* ptr, const std::nothrow_t& /*unused*/) noexcept -> void
+{
+    deallocate(ptr);
+}
+
+auto operator delete[](void* ptr, const std::nothrow_t& /*unused*/) noexcept -> void
+{
+    deallocate(ptr);
+}
+
+auto operator delete(
+    void* ptr, std::align_val_t alignment, const std::nothrow_t& /*unused*/) noexcept -> void
+{
+    deallocate(ptr, alignment);
+}
+
+auto operator delete[](
+    void* ptr, std::align_val_t alignment, const std::nothrow_t& /*unused*/) noexcept -> void
+{
+    deallocate(ptr, alignment);
+}
+// NOLINTEND(*-new-delete-overloads)
@@ -0,0 +1,33 @@
+/**
+ * @file allocation_counter.h
+ * @brief Contains the declaration of the AllocationCounter class.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace SlimLog::Bench {
+
+/**
+ * @brief Counter of the heap allocations made by the calling thread.
+ *
+ * The benchmark executable replaces the global `operator new` family, so every
+ * allocation made through the standard allocators, containers and the formatting
+ * libraries is counted. Allocations made directly with `malloc()` (e.g. by zlib)
+ * are not intercepted.
+ *
+ * The counter is per thread, so that the allocations of the helper threads
+ * (e.g. a compressor) are not attributed to the logging call being measured.
+ */
+class AllocationCounter final {
+public:
+    /**
+     * @brief Gets the number of allocations made by the calling thread so far.
+     *
+     * @return Number of allocations.
+     */
+    [[nodiscard]] static auto count() noexcept -> std::uint64_t;
+};
+
+} // namespace SlimLog::Bench
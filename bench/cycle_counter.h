@@ -0,0 +1,104 @@
+/**
+ * @file cycle_counter.h
+ * @brief Contains the definition of the CycleCounter class.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace SlimLog::Bench {
+
+/**
+ * @brief Serializing cycle counter for per-call latency measurements.
+ *
+ * Reads the time stamp counter on x86 (`lfence; rdtsc` before the measured code,
+ * `rdtscp; lfence` after it, so that the code cannot be reordered across the reads)
+ * and the virtual counter on AArch64 (`isb; mrs cntvct_el0`). Falls back to
+ * `std::chrono::steady_clock` nanoseconds elsewhere.
+ */
+class CycleCounter final {
+public:
+    /**
+     * @brief Reads the counter before the measured code.
+     *
+     * @return Counter value.
+     */
+    [[nodiscard]] static auto start() noexcept -> std::uint64_t
+    {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+        _mm_lfence();
+        const auto ticks = __rdtsc();
+        _mm_lfence();
+        return ticks;
+#elif defined(__aarch64__)
+        std::uint64_t ticks = 0;
+        asm volatile("isb; mrs %0, cntvct_el0" : "=r"(ticks)::"memory");
+        return ticks;
+#else
+        return steady_ticks();
+#endif
+    }
+
+    /**
+     * @brief Reads the counter after the measured code.
+     *
+     * @return Counter value.
+     */
+    [[nodiscard]] static auto stop() noexcept -> std::uint64_t
+    {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+        unsigned int aux = 0;
+        const auto ticks = __rdtscp(&aux);
+        _mm_lfence();
+        return ticks;
+#elif defined(__aarch64__)
+        std::uint64_t ticks = 0;
+        asm volatile("isb; mrs %0, cntvct_el0; isb" : "=r"(ticks)::"memory");
+        return ticks;
+#else
+        return steady_ticks();
+#endif
+    }
+
+    /**
+     * @brief Measures the counter frequency against the steady clock.
+     *
+     * @param duration Calibration duration.
+     * @return Number of counter ticks per nanosecond.
+     */
+    [[nodiscard]] static auto ticks_per_ns(
+        std::chrono::milliseconds duration = std::chrono::milliseconds(20)) -> double
+    {
+        using Clock = std::chrono::steady_clock;
+        const auto clock_start = Clock::now();
+        const auto ticks_start = start();
+        std::this_thread::sleep_for(duration);
+        const auto ticks_stop = stop();
+        const std::chrono::duration<double, std::nano> elapsed = Clock::now() - clock_start;
+        return static_cast<double>(ticks_stop - ticks_start) / elapsed.count();
+    }
+
+private:
+    /**
+     * @brief Reads the steady clock in nanoseconds.
+     *
+     * @return Steady clock nanoseconds.
+     */
+    [[maybe_unused]] static auto steady_ticks() noexcept -> std::uint64_t
+    {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                              std::chrono::steady_clock::now().time_since_epoch())
+                                              .count());
+    }
+};
+
+} // namespace SlimLog::Bench
@@ -0,0 +1,507 @@
+/**
+ * @file main.cpp
+ * @brief Logger benchmark scenarios.
+ */
+
+#include "runner.h"
+
+#include <slimlog/clock.h>
+#include <slimlog/level.h>
+#include <slimlog/logger.h>
+#include <slimlog/policy.h>
+#include <slimlog/sinks/binary_file_sink.h>
+#include <slimlog/sinks/dedup_sink.h>
+#include <slimlog/sinks/file_sink.h>
+#include <slimlog/sinks/null_sink.h>
+#include <slimlog/sinks/ostream_sink.h>
+#include <slimlog/sinks/ring_buffer_sink.h>
+#include <slimlog/sinks/throttling_sink.h>
+#include <slimlog/sinks/time_rotating_file_sink.h>
+
+#ifdef SLIMLOG_ZLIB
+#include <slimlog/sinks/compressed_file_sink.h>
+#endif
+
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace {
+
+namespace Log = SlimLog;
+namespace Bench = SlimLog::Bench;
+
+/** @brief Seed of the input data generator, fixed for reproducible runs. */
+constexpr std::mt19937::result_type Seed = 20240229;
+
+/** @brief Number of the pre-generated input strings cycled through by the scenarios. */
+constexpr std::size_t InputCount = 64;
+
+constexpr std::string_view Usage
+    = "Usage: slimlog-bench [--list] [--filter <substring>] [--repetitions <count>]\n"
+      "                     [--min-time <ms>] [--threads <count>] [--samples <count>]\n"
+      "                     [--no-scaling] [--no-pin] [--no-counters] [--check-allocations]\n"
+      "                     [--output <file>] [--csv <file>]\n";
+
+/**
+ * @brief Stream buffer discarding the output.
+ *
+ * @tparam Char Character type.
+ */
+template<typename Char>
+class NullBuffer final : public std::basic_streambuf<Char> {
+protected:
+    auto xsputn(const Char* /*unused*/, std::streamsize count) -> std::streamsize override
+    {
+        return count;
+    }
+
+    auto overflow(typename std::basic_streambuf<Char>::int_type chr) ->
+        typename std::basic_streambuf<Char>::int_type override
+    {
+        return chr;
+    }
+};
+
+/**
+ * @brief Logger hierarchy writing to a discarding stream.
+ *
+ * @tparam Char Character type.
+ * @tparam Clock Clock policy of the loggers.
+ */
+template<typename Char, typename Clock = Log::RealtimeClock>
+class Fixture final {
+public:
+    /** @brief Logger type. */
+    using LoggerType = Log::Logger<
+        std::basic_string_view<Char>,
+        Char,
+        Log::DefaultThreadingPolicy,
+        Log::DefaultBufferSize,
+        std::allocator<Char>,
+        Clock>;
+
+    /**
+     * @brief Constructs a new Fixture object.
+     *
+     * @param pattern Sink pattern.
+     * @param sinks Number of the sinks of the root logger.
+     * @param depth Number of the descendants of the root logger in a chain.
+     * @param level Logging level of all loggers.
+     */
+    Fixture(
+        std::basic_string_view<Char> pattern,
+        std::size_t sinks = 1,
+        std::size_t depth = 0,
+        Log::Level level = Log::Level::Info)
+    {
+        const std::basic_string<Char> category{Char{'n'}, Char{'o'}, Char{'d'}, Char{'e'}};
+        m_loggers.push_back(std::make_unique<LoggerType>(category, level));
+        for (std::size_t i = 0; i < sinks; ++i) {
+            m_loggers.front()->template add_sink<Log::OStreamSink>(m_stream, pattern);
+        }
+        for (std::size_t i = 0; i < depth; ++i) {
+            m_loggers.push_back(std::make_unique<LoggerType>(category, level, *m_loggers.back()));
+        }
+    }
+
+    /**
+     * @brief Gets the deepest logger.
+     *
+     * @return Logger reference.
+     */
+    [[nodiscard]] auto logger() const -> const LoggerType&
+    {
+        return *m_loggers.back();
+    }
+
+private:
+    NullBuffer<Char> m_buffer;
+    std::basic_ostream<Char> m_stream{&m_buffer};
+    std::vector<std::unique_ptr<LoggerType>> m_loggers;
+};
+
+/**
+ * @brief Generates random strings from the alphabet.
+ *
+ * @tparam Char Character type.
+ * @param alphabet Characters to pick from.
+ * @param length Length of each string.
+ * @return InputCount strings.
+ */
+template<typename Char>
+auto generate(std::basic_string_view<Char> alphabet, std::size_t length)
+    -> std::vector<std::basic_string<Char>>
+{
+    std::mt19937 generator(Seed);
+    std::uniform_int_distribution<std::size_t> distribution(0, alphabet.size() - 1);
+    std::vector<std::basic_string<Char>> result(InputCount);
+    for (auto& str : result) {
+        str.reserve(length);
+        for (std::size_t i = 0; i < length; ++i) {
+            str.push_back(alphabet[distribution(generator)]);
+        }
+    }
+    return result;
+}
+
+constexpr std::string_view Alphabet = "0123456789"
+                                      "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                                      "abcdefghijklmnopqrstuvwxyz"
+                                      "!@#$%^&*()-=,./?`~\"' ";
+
+constexpr std::wstring_view WideAlphabet = L"0123456789"
+                                           L"ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                                           L"АБВГДЕЁЖЗИЙКЛМНОПРСТУФХЦЧШЩЪЫЬЭЮЯ"
+                                           L"абвгдеёжзийклмнопрстуфхцчшщъыьэюя"
+                                           L"!@#$%^&*()-=,./?`~\"' ";
+
+constexpr std::string_view Pattern
+    = "({category}) [{level}] <{time:%Y-%m-%d %T}.{msec}> {file}|{line}: {message}";
+
+constexpr std::wstring_view WidePattern
+    = L"({category}) [{level}] <{time:%Y-%m-%d %T}.{msec}> {file}|{line}: {message}";
+
+/**
+ * @brief Registers a scenario logging two integers through the fixture.
+ *
+ * @param runner Benchmark runner.
+ * @param name Scenario name.
+ * @param sinks Number of the sinks.
+ * @param depth Depth of the logger hierarchy.
+ */
+auto add_fanout(Bench::Runner& runner, std::string name, std::size_t sinks, std::size_t depth)
+    -> void
+{
+    runner.add(std::move(name), [sinks, depth]() -> Bench::Runner::Workload {
+        auto fixture = std::make_shared<Fixture<char>>(Pattern, sinks, depth);
+        return Bench::Runner::workload([fixture](std::size_t i) {
+            fixture->logger().info("Message {} of {}", i, i * 2);
+        });
+    });
+}
+
+/**
+ * @brief Logger with a single sink of the given kind, shared by concurrent producers.
+ *
+ * File-based sinks write into a scratch directory removed with the fixture.
+ *
+ * @tparam ThreadingPolicy Threading policy of the logger.
+ */
+template<typename ThreadingPolicy>
+class ScalingFixture final {
+public:
+    /** @brief Logger type. */
+    using LoggerType = Log::Logger<std::string_view, char, ThreadingPolicy>;
+
+    /**
+     * @brief Constructs a new ScalingFixture object.
+     *
+     * @param name Scenario name, used for the scratch directory.
+     * @param sink Sink kind (see add_scaling()).
+     */
+    ScalingFixture(std::string_view name, std::string_view sink)
+        : m_directory(std::filesystem::temp_directory_path() / ("slimlog-bench-" + std::string(name)))
+        , m_logger("node")
+    {
+        std::filesystem::create_directories(m_directory);
+        const auto file = (m_directory / "bench.log").string();
+        using TargetType = Log::NullSink<std::string_view, char>;
+        if (sink == "null") {
+            m_sink = m_logger.template add_sink<Log::NullSink>();
+        } else if (sink == "ostream") {
+            m_sink = m_logger.template add_sink<Log::OStreamSink>(m_stream, Pattern);
+        } else if (sink == "file") {
+            m_sink = m_logger.template add_sink<Log::FileSink>(file, Pattern);
+        } else if (sink == "binary_file") {
+            m_sink = m_logger.template add_sink<Log::BinaryFileSink>(file);
+        } else if (sink == "time_rotating_file") {
+            m_sink = m_logger.template add_sink<Log::TimeRotatingFileSink>(
+                file, Log::RotationPeriod::Daily, Pattern);
+#ifdef SLIMLOG_ZLIB
+        } else if (sink == "compressed_file") {
+            m_sink = m_logger.template add_sink<Log::CompressedFileSink>(file, Pattern);
+#endif
+        } else if (sink == "ring_buffer") {
+            constexpr std::size_t Capacity = 1024;
+            m_sink = m_logger.template add_sink<Log::RingBufferSink>(
+                std::make_shared<TargetType>(), Capacity);
+        } else if (sink == "dedup") {
+            m_sink = m_logger.template add_sink<Log::DedupSink>(std::make_shared<TargetType>());
+        } else if (sink == "throttling") {
+            // The budget is never exhausted, so only the accounting is measured
+            constexpr double Budget = 1e12;
+            m_sink = m_logger.template add_sink<Log::ThrottlingSink>(
+                std::make_shared<TargetType>(), Budget);
+        } else {
+            throw std::invalid_argument("Unknown sink " + std::string(sink));
+        }
+    }
+
+    ScalingFixture(const ScalingFixture&) = delete;
+    ScalingFixture(ScalingFixture&&) = delete;
+    auto operator=(const ScalingFixture&) -> ScalingFixture& = delete;
+    auto operator=(ScalingFixture&&) -> ScalingFixture& = delete;
+
+    ~ScalingFixture()
+    {
+        // Close the files before removing them
+        m_logger.remove_sink(m_sink);
+        m_sink.reset();
+        std::error_code error;
+        std::filesystem::remove_all(m_directory, error);
+    }
+
+    /**
+     * @brief Gets the logger.
+     *
+     * @return Logger reference.
+     */
+    [[nodiscard]] auto logger() const -> const LoggerType&
+    {
+        return m_logger;
+    }
+
+private:
+    std::filesystem::path m_directory;
+    NullBuffer<char> m_buffer;
+    std::ostream m_stream{&m_buffer};
+    LoggerType m_logger;
+    std::shared_ptr<typename LoggerType::SinkType> m_sink;
+};
+
+/**
+ * @brief Registers the scenarios logging from concurrent producers into each sink kind.
+ *
+ * @tparam ThreadingPolicy Threading policy of the logger.
+ * @param runner Benchmark runner.
+ * @param policy Short policy name used in the scenario names.
+ * @param max_threads Maximum number of the concurrent producers, zero for no limit.
+ */
+template<typename ThreadingPolicy>
+auto add_scaling(Bench::Runner& runner, std::string_view policy, std::size_t max_threads = 0)
+    -> void
+{
+    // Sink kinds with their allocation budgets
+    std::vector<std::pair<std::string_view, double>> sinks{
+        {"null", 0},
+        {"ostream", 0},
+        {"file", 0},
+        {"binary_file", 0},
+        {"time_rotating_file", 0},
+        {"ring_buffer", 0},
+        {"dedup", 0},
+        {"throttling", 0}};
+#ifdef SLIMLOG_ZLIB
+    // A new 64 KiB block is reserved while the compressor still holds the previous ones
+    constexpr double BlockAllocations = 0.01;
+    sinks.emplace_back("compressed_file", BlockAllocations);
+#endif
+
+    for (const auto& [sink, allocation_budget] : sinks) {
+        auto name = "scaling_" + std::string(policy) + '_' + std::string(sink);
+        runner.add(
+            name,
+            [name, sink]() -> Bench::Runner::Workload {
+                auto fixture = std::make_shared<ScalingFixture<ThreadingPolicy>>(name, sink);
+                return Bench::Runner::workload([fixture](std::size_t i) {
+                    fixture->logger().info("Message {} of {}", i, i * 2);
+                });
+            },
+            allocation_budget,
+            max_threads);
+    }
+}
+
+/**
+ * @brief Registers a scenario logging two integers with the given clock policy.
+ *
+ * @tparam Clock Clock policy of the logger.
+ * @param runner Benchmark runner.
+ * @param name Scenario name.
+ */
+template<typename Clock>
+auto add_clock(Bench::Runner& runner, std::string name) -> void
+{
+    runner.add(std::move(name), []() -> Bench::Runner::Workload {
+        auto fixture = std::make_shared<Fixture<char, Clock>>(Pattern);
+        // Initialize the clock (e.g. calibrate the cycle counter) before the timing
+        std::ignore = Clock::now();
+        return Bench::Runner::workload([fixture](std::size_t i) {
+            fixture->logger().info("Message {} of {}", i, i * 2);
+        });
+    });
+}
+
+auto add_scenarios(Bench::Runner& runner) -> void
+{
+    runner.add("filtered_out", []() -> Bench::Runner::Workload {
+        auto fixture = std::make_shared<Fixture<char>>(Pattern);
+        return Bench::Runner::workload([fixture](std::size_t i) {
+            fixture->logger().message(Log::Level::Debug, "Filtered {} of {}", i, i * 2);
+        });
+    });
+
+    runner.add("constant_string", []() -> Bench::Runner::Workload {
+        auto fixture = std::make_shared<Fixture<char>>(Pattern);
+        return Bench::Runner::workload([fixture](std::size_t /*unused*/) {
+            fixture->logger().info("Constant message without arguments");
+        });
+    });
+
+    runner.add("int_args_1", []() -> Bench::Runner::Workload {
+        auto fixture = std::make_shared<Fixture<char>>(Pattern);
+        return Bench::Runner::workload([fixture](std::size_t i) {
+            fixture->logger().info("Integers: {}", i);
+        });
+    });
+
+    runner.add("int_args_2", []() -> Bench::Runner::Workload {
+        auto fixture = std::make_shared<Fixture<char>>(Pattern);
+        return Bench::Runner::workload([fixture](std::size_t i) {
+            fixture->logger().info("Integers: {} {}", i, i * 3);
+        });
+    });
+
+    runner.add("int_args_3", []() -> Bench::Runner::Workload {
+        auto fixture = std::make_shared<Fixture<char>>(Pattern);
+        return Bench::Runner::workload([fixture](std::size_t i) {
+            fixture->logger().info("Integers: {} {} {}", i, i * 3, -7);
+        });
+    });
+
+    runner.add("int_args_4", []() -> Bench::Runner::Workload {
+        auto fixture = std::make_shared<Fixture<char>>(Pattern);
+        return Bench::Runner::workload([fixture](std::size_t i) {
+            fixture->logger().info("Integers: {} {} {} {}", i, i * 3, -7, 123456789LL);
+        });
+    });
+
+    // The message outgrows the inline buffers of the logger and of the sink
+    constexpr double LongStringAllocations = 3;
+    runner.add(
+        "long_string",
+        []() -> Bench::Runner::Workload {
+            constexpr std::size_t Length = 1024;
+            auto fixture = std::make_shared<Fixture<char>>(Pattern);
+            auto input = std::make_shared<std::vector<std::string>>(generate(Alphabet, Length));
+            return Bench::Runner::workload([fixture, input](std::size_t i) {
+                fixture->logger().info("Long string: {}", (*input)[i % InputCount]);
+            });
+        },
+        LongStringAllocations);
+
+    runner.add("wide_chars", []() -> Bench::Runner::Workload {
+        constexpr std::size_t Length = 64;
+        auto fixture = std::make_shared<Fixture<wchar_t>>(WidePattern);
+        auto input = std::make_shared<std::vector<std::wstring>>(generate(WideAlphabet, Length));
+        return Bench::Runner::workload([fixture, input](std::size_t i) {
+            fixture->logger().info(L"Wide string {}: {}", i, (*input)[i % InputCount]);
+        });
+    });
+
+    runner.add("padded_fields", []() -> Bench::Runner::Workload {
+        constexpr std::size_t Length = 8;
+        auto fixture = std::make_shared<Fixture<char>>(
+            "[{level:<8}] {category:>12} {file:>20}|{line:<5}: {message}");
+        auto input = std::make_shared<std::vector<std::string>>(generate(Alphabet, Length));
+        return Bench::Runner::workload([fixture, input](std::size_t i) {
+            fixture->logger().info(
+                "{:>12}|{:<12}|{:^12}|{:08x}", i, (*input)[i % InputCount], 3.5, i);
+        });
+    });
+
+    // The time stands still: no clock reads, the time fields are formatted once
+    runner.add("clock_fixed", []() -> Bench::Runner::Workload {
+        auto fixture = std::make_shared<Fixture<char, Log::ManualClock>>(Pattern);
+        Log::ManualClock::set(std::chrono::sys_days{std::chrono::January / 1 / 2024});
+        return Bench::Runner::workload([fixture](std::size_t i) {
+            fixture->logger().info("Message {} of {}", i, i * 2);
+        });
+    });
+
+    // Every record falls into a new second: the time fields are formatted each time
+    runner.add("clock_rollover", []() -> Bench::Runner::Workload {
+        auto fixture = std::make_shared<Fixture<char, Log::ManualClock>>(Pattern);
+        Log::ManualClock::set(std::chrono::sys_days{std::chrono::January / 1 / 2024});
+        return Bench::Runner::workload([fixture](std::size_t i) {
+            Log::ManualClock::advance(std::chrono::seconds(1));
+            fixture->logger().info("Message {} of {}", i, i * 2);
+        });
+    });
+
+    add_clock<Log::TscClock>(runner, "clock_tsc");
+    add_clock<Log::UtcClock>(runner, "clock_utc");
+    add_clock<Log::OffsetClock>(runner, "clock_offset");
+
+    add_fanout(runner, "sinks_1", 1, 0);
+    add_fanout(runner, "sinks_10", 10, 0);
+    add_fanout(runner, "sinks_1000", 1000, 0);
+    add_fanout(runner, "hierarchy_depth_10", 1, 10);
+    add_fanout(runner, "hierarchy_depth_100", 1, 100);
+
+    add_scaling<Log::MultiThreadedPolicy>(runner, "mt");
+    // Single-threaded loggers must not be called concurrently
+    add_scaling<Log::SingleThreadedPolicy>(runner, "st", 1);
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+    Bench::Options options;
+    try {
+        options = Bench::parse_options(argc, argv);
+    } catch (const std::invalid_argument& e) {
+        std::cerr << e.what() << '\n' << Usage;
+        return 2;
+    }
+
+    try {
+        Bench::Runner runner(options);
+        add_scenarios(runner);
+        if (options.list) {
+            runner.list(std::cout);
+            return 0;
+        }
+
+        const auto passed = runner.run(std::cerr);
+        if (!options.csv.empty()) {
+            std::ofstream csv(options.csv);
+            runner.write_csv(csv);
+            if (!csv) {
+                throw std::runtime_error("Failed writing " + options.csv);
+            }
+        }
+        if (options.output.empty()) {
+            runner.write_json(std::cout);
+        } else {
+            std::ofstream output(options.output);
+            runner.write_json(output);
+            if (!output) {
+                throw std::runtime_error("Failed writing " + options.output);
+            }
+        }
+        if (!passed) {
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Exception: " << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,129 @@
+/**
+ * @file perf_counters.cpp
+ * @brief Contains the definition of the PerfCounters class.
+ */
+
+#include "perf_counters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <tuple>
+
+namespace SlimLog::Bench {
+
+#ifdef __linux__
+namespace {
+// Order must match PerfCounters::EventNames
+constexpr std::array<std::uint64_t, PerfCounters::EventCount> EventConfigs{
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES};
+
+auto open_event(std::uint64_t config) -> int
+{
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = 1;
+    // User space only: allowed with the default perf_event_paranoid level
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    // Calling thread on any CPU
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+} // namespace
+
+PerfCounters::PerfCounters()
+{
+    for (std::size_t i = 0; i < EventCount; ++i) {
+        m_fds[i] = open_event(EventConfigs[i]); // NOLINT(*-constant-array-index)
+    }
+}
+
+PerfCounters::~PerfCounters()
+{
+    for (const auto fd : m_fds) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+}
+
+auto PerfCounters::start() noexcept -> void
+{
+    for (const auto fd : m_fds) {
+        if (fd >= 0) {
+            std::ignore = ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            std::ignore = ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+auto PerfCounters::stop() noexcept -> void
+{
+    for (const auto fd : m_fds) {
+        if (fd >= 0) {
+            std::ignore = ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+}
+
+auto PerfCounters::read() const -> std::vector<std::pair<std::string_view, double>>
+{
+    struct {
+        std::uint64_t value;
+        std::uint64_t time_enabled;
+        std::uint64_t time_running;
+    } data{};
+
+    std::vector<std::pair<std::string_view, double>> result;
+    for (std::size_t i = 0; i < EventCount; ++i) {
+        const auto fd = m_fds[i]; // NOLINT(*-constant-array-index)
+        if (fd < 0 || ::read(fd, &data, sizeof(data)) != sizeof(data) || data.time_running == 0) {
+            continue;
+        }
+        // Extrapolate if the counter was multiplexed with others
+        const auto scale
+            = static_cast<double>(data.time_enabled) / static_cast<double>(data.time_running);
+        result.emplace_back(EventNames[i], static_cast<double>(data.value) * scale);
+    }
+    return result;
+}
+#else
+PerfCounters::PerfCounters() = default;
+
+PerfCounters::~PerfCounters() = default;
+
+auto PerfCounters::start() noexcept -> void
+{
+}
+
+auto PerfCounters::stop() noexcept -> void
+{
+}
+
+auto PerfCounters::read() const -> std::vector<std::pair<std::string_view, double>>
+{
+    return {};
+}
+#endif
+
+auto PerfCounters::available() const noexcept -> bool
+{
+    for (const auto fd : m_fds) {
+        if (fd >= 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace SlimLog::Bench
@@ -0,0 +1,80 @@
+/**
+ * @file perf_counters.h
+ * @brief Contains the declaration of the PerfCounters class.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace SlimLog::Bench {
+
+/**
+ * @brief Hardware performance counters of the calling thread.
+ *
+ * Opens the cycles, instructions, cache misses and branch misses counters via
+ * Linux `perf_event_open()`, counting the user space of the calling thread only.
+ * Each counter is opened separately, so that the ones not supported by the CPU
+ * or forbidden by `perf_event_paranoid` are skipped, and the values are scaled
+ * if the kernel had to multiplex the counters.
+ *
+ * On other platforms, or when no counter can be opened, the counters are
+ * unavailable and read() returns an empty list.
+ */
+class PerfCounters final {
+public:
+    /** @brief Number of the supported counters. */
+    static constexpr std::size_t EventCount = 4;
+
+    /** @brief Names of the supported counters. */
+    static constexpr std::array<std::string_view, EventCount> EventNames{
+        "cycles", "instructions", "cache_misses", "branch_misses"};
+
+    /**
+     * @brief Opens the counters.
+     */
+    PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters(PerfCounters&&) = delete;
+    auto operator=(const PerfCounters&) -> PerfCounters& = delete;
+    auto operator=(PerfCounters&&) -> PerfCounters& = delete;
+
+    /**
+     * @brief Closes the counters.
+     */
+    ~PerfCounters();
+
+    /**
+     * @brief Checks if any counter has been opened.
+     *
+     * @return \b true if at least one counter is available.
+     */
+    [[nodiscard]] auto available() const noexcept -> bool;
+
+    /**
+     * @brief Resets and starts the counters.
+     */
+    auto start() noexcept -> void;
+
+    /**
+     * @brief Stops the counters.
+     */
+    auto stop() noexcept -> void;
+
+    /**
+     * @brief Reads the counters accumulated between start() and stop().
+     *
+     * @return Names and values of the available counters.
+     */
+    [[nodiscard]] auto read() const -> std::vector<std::pair<std::string_view, double>>;
+
+private:
+    std::array<int, EventCount> m_fds{-1, -1, -1, -1};
+};
+
+} // namespace SlimLog::Bench
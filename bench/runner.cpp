@@ -0,0 +1,471 @@
+/**
+ * @file runner.cpp
+ * @brief Contains definition of the benchmark Runner class.
+ */
+
+#include "runner.h"
+
+#include "allocation_counter.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h> // for SetThreadAffinityMask
+#elif defined(__linux__)
+#include <pthread.h> // for pthread_setaffinity_np
+#include <sched.h> // for sched_getaffinity
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <ctime>
+#include <iomanip>
+#include <limits>
+#include <numeric>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <utility>
+
+namespace SlimLog::Bench {
+
+namespace {
+auto to_size(std::string_view option, const std::string& value) -> std::size_t
+{
+    try {
+        std::size_t pos = 0;
+        const auto result = std::stoull(value, &pos);
+        if (pos == value.size() && result > 0) {
+            return result;
+        }
+    } catch (const std::exception&) {
+        // Reported below
+    }
+    throw std::invalid_argument(std::string(option) + ": expected positive number");
+}
+
+auto percentile(std::vector<double> values, double fraction) -> double
+{
+    const auto nth = static_cast<std::size_t>(
+        std::lround(fraction * static_cast<double>(values.size() - 1)));
+    std::nth_element(values.begin(), std::next(values.begin(), nth), values.end());
+    return values[nth];
+}
+
+auto write_string(std::ostream& out, std::string_view value) -> void
+{
+    out << '"';
+    for (const char chr : value) {
+        if (chr == '"' || chr == '\\') {
+            out << '\\' << chr;
+        } else if (static_cast<unsigned char>(chr) < ' ') {
+            out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                << static_cast<int>(chr) << std::dec << std::setfill(' ');
+        } else {
+            out << chr;
+        }
+    }
+    out << '"';
+}
+
+auto allowed_cpus() -> std::vector<unsigned>
+{
+    std::vector<unsigned> cpus;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (unsigned cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+#endif
+    if (cpus.empty()) {
+        cpus.resize(std::max(1U, std::thread::hardware_concurrency()));
+        std::iota(cpus.begin(), cpus.end(), 0U);
+    }
+    return cpus;
+}
+
+auto pin_thread(unsigned cpu) -> void
+{
+    // Best effort: the measurements stay valid, just noisier, if pinning fails
+#ifdef _WIN32
+    std::ignore = SetThreadAffinityMask(
+        GetCurrentThread(), DWORD_PTR{1} << (cpu % (sizeof(DWORD_PTR) * CHAR_BIT)));
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    std::ignore = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    static_cast<void>(cpu);
+#endif
+}
+
+auto compiler() -> std::string_view
+{
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc";
+#else
+    return "unknown";
+#endif
+}
+} // namespace
+
+auto parse_options(int argc, char* argv[]) -> Options // NOLINT(*-avoid-c-arrays)
+{
+    Options options;
+    const std::span<char*> args(argv, static_cast<std::size_t>(argc));
+    for (auto itr = std::next(args.begin()); itr != args.end(); ++itr) {
+        std::string_view arg = *itr;
+        std::string value;
+        if (const auto equal = arg.find('='); equal != std::string_view::npos) {
+            value = arg.substr(equal + 1);
+            arg = arg.substr(0, equal);
+        }
+        const auto next_value = [&]() -> const std::string& {
+            if (value.empty()) {
+                if (std::next(itr) == args.end()) {
+                    throw std::invalid_argument(std::string(arg) + ": missing value");
+                }
+                value = *++itr;
+            }
+            return value;
+        };
+
+        if (arg == "--list") {
+            options.list = true;
+        } else if (arg == "--filter") {
+            options.filter = next_value();
+        } else if (arg == "--output") {
+            options.output = next_value();
+        } else if (arg == "--csv") {
+            options.csv = next_value();
+        } else if (arg == "--repetitions") {
+            options.repetitions = to_size(arg, next_value());
+        } else if (arg == "--min-time") {
+            options.min_time = std::chrono::milliseconds(to_size(arg, next_value()));
+        } else if (arg == "--threads") {
+            options.threads = to_size(arg, next_value());
+        } else if (arg == "--samples") {
+            options.samples = to_size(arg, next_value());
+        } else if (arg == "--no-scaling") {
+            options.scaling = false;
+        } else if (arg == "--no-pin") {
+            options.pin = false;
+        } else if (arg == "--check-allocations") {
+            options.check_allocations = true;
+        } else if (arg == "--no-counters") {
+            options.counters = false;
+        } else {
+            throw std::invalid_argument(std::string(arg) + ": unknown option");
+        }
+    }
+    return options;
+}
+
+Runner::Runner(Options options)
+    : m_options(std::move(options))
+    , m_cpus(allowed_cpus())
+{
+    if (m_options.threads == 0) {
+        m_options.threads = m_cpus.size();
+    }
+    if (m_options.counters) {
+        m_counters.emplace();
+        if (!m_counters->available()) {
+            m_counters.reset();
+        }
+    }
+    if (!m_options.scaling) {
+        return;
+    }
+
+    m_ticks_per_ns = CycleCounter::ticks_per_ns();
+    // Cost of the counter reads themselves, included in every latency sample
+    constexpr int OverheadSamples = 1000;
+    m_counter_overhead = std::numeric_limits<std::uint64_t>::max();
+    for (int i = 0; i < OverheadSamples; ++i) {
+        const auto start = CycleCounter::start();
+        m_counter_overhead = std::min(m_counter_overhead, CycleCounter::stop() - start);
+    }
+}
+
+auto Runner::add(
+    std::string name, Setup setup, double allocation_budget, std::size_t max_threads) -> void
+{
+    m_scenarios.push_back({std::move(name), std::move(setup), allocation_budget, max_threads});
+}
+
+auto Runner::run(std::ostream& log) -> bool
+{
+    using Clock = std::chrono::steady_clock;
+
+    bool passed = true;
+    for (const auto& scenario : m_scenarios) {
+        if (scenario.name.find(m_options.filter) == std::string::npos) {
+            continue;
+        }
+
+        const auto workload = scenario.setup();
+        // Calibration doubles as the warm-up
+        Result result{
+            scenario.name, calibrate(workload.body), {}, 0, scenario.allocation_budget, {}, {}};
+        result.ns_per_op.reserve(m_options.repetitions);
+        if (m_counters) {
+            m_counters->start();
+        }
+        const auto allocations = AllocationCounter::count();
+        for (std::size_t i = 0; i < m_options.repetitions; ++i) {
+            const auto start = Clock::now();
+            workload.body(result.iterations);
+            const std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+            result.ns_per_op.push_back(elapsed.count() / static_cast<double>(result.iterations));
+        }
+        const auto operations = static_cast<double>(result.iterations * m_options.repetitions);
+        result.allocations_per_op
+            = static_cast<double>(AllocationCounter::count() - allocations) / operations;
+        if (m_counters) {
+            m_counters->stop();
+            result.counters = m_counters->read();
+            for (auto& counter : result.counters) {
+                counter.second /= operations;
+            }
+        }
+
+        log << scenario.name << ": " << percentile(result.ns_per_op, 0.5) << " ns/op, "
+            << result.allocations_per_op << " allocations/op";
+        for (const auto& [name, value] : result.counters) {
+            log << ", " << value << ' ' << name << "/op";
+        }
+        log << '\n';
+        if (m_options.check_allocations && result.allocations_per_op > result.allocation_budget) {
+            log << scenario.name << ": allocation budget of " << result.allocation_budget
+                << "/op exceeded\n";
+            passed = false;
+        }
+
+        if (m_options.scaling) {
+            const auto samples = m_options.samples == 0 ? result.iterations : m_options.samples;
+            const auto max_threads = scenario.max_threads == 0
+                ? m_options.threads
+                : std::min(scenario.max_threads, m_options.threads);
+            for (std::size_t threads = 1;; threads = std::min(threads * 2, max_threads)) {
+                const auto& scaling = result.scaling.emplace_back(
+                    measure_scaling(workload, threads, result.iterations, samples));
+                log << scenario.name << " [" << threads << " threads]: "
+                    << scaling.ops_per_second / 1e6 << " Mops/s, p50 "
+                    << to_ns(scaling.histogram.percentile(50.0)) << " ns, p99.9 "
+                    << to_ns(scaling.histogram.percentile(99.9)) << " ns\n";
+                if (threads == max_threads) {
+                    break;
+                }
+            }
+        }
+        m_results.push_back(std::move(result));
+    }
+    return passed;
+}
+
+auto Runner::list(std::ostream& out) const -> void
+{
+    for (const auto& scenario : m_scenarios) {
+        out << scenario.name << '\n';
+    }
+}
+
+auto Runner::write_json(std::ostream& out) const -> void
+{
+    const auto now = std::time(nullptr);
+    std::tm utc{};
+#ifdef _WIN32
+    gmtime_s(&utc, &now);
+#else
+    gmtime_r(&now, &utc);
+#endif
+
+    out << "{\n  \"context\": {\n";
+    out << "    \"date\": \"" << std::put_time(&utc, "%Y-%m-%dT%H:%M:%SZ") << "\",\n";
+    out << "    \"compiler\": ";
+    write_string(out, compiler());
+    out << ",\n    \"format\": \""
+#ifdef SLIMLOG_FMTLIB
+        << "fmt"
+#else
+        << "std"
+#endif
+        << "\",\n";
+    out << "    \"repetitions\": " << m_options.repetitions << ",\n";
+    out << "    \"min_time_ms\": " << m_options.min_time.count() << ",\n";
+    out << "    \"cpus\": " << m_cpus.size() << ",\n";
+    out << "    \"pinned\": " << (m_options.pin ? "true" : "false") << ",\n";
+    out << "    \"perf_counters\": " << (m_counters ? "true" : "false") << ",\n";
+    out << "    \"ticks_per_ns\": " << m_ticks_per_ns << ",\n";
+    out << "    \"counter_overhead_ns\": " << to_ns(m_counter_overhead) << "\n  },\n";
+
+    out << "  \"benchmarks\": [";
+    const char* separator = "\n";
+    for (const auto& result : m_results) {
+        const auto& values = result.ns_per_op;
+        const auto mean
+            = std::accumulate(values.begin(), values.end(), 0.0) / static_cast<double>(values.size());
+        out << separator << "    {\"name\": ";
+        write_string(out, result.name);
+        out << ", \"iterations\": " << result.iterations
+            << ", \"ns_per_op\": {\"min\": " << *std::min_element(values.begin(), values.end())
+            << ", \"median\": " << percentile(values, 0.5)
+            << ", \"p90\": " << percentile(values, 0.9) << ", \"mean\": " << mean
+            << ", \"max\": " << *std::max_element(values.begin(), values.end()) << "}"
+            << ", \"allocations_per_op\": " << result.allocations_per_op
+            << ", \"allocation_budget\": " << result.allocation_budget;
+        out << ", \"counters_per_op\": {";
+        const char* counter_separator = "";
+        for (const auto& [name, value] : result.counters) {
+            out << counter_separator;
+            write_string(out, name);
+            out << ": " << value;
+            counter_separator = ", ";
+        }
+        out << "}";
+        out << ", \"scaling\": [";
+        const char* scaling_separator = "";
+        for (const auto& scaling : result.scaling) {
+            const auto& histogram = scaling.histogram;
+            out << scaling_separator << "{\"threads\": " << scaling.threads
+                << ", \"ops_per_sec\": " << scaling.ops_per_second
+                << ", \"samples\": " << histogram.count()
+                << ", \"latency_ns\": {\"p50\": " << to_ns(histogram.percentile(50.0))
+                << ", \"p99\": " << to_ns(histogram.percentile(99.0))
+                << ", \"p99.9\": " << to_ns(histogram.percentile(99.9))
+                << ", \"p99.99\": " << to_ns(histogram.percentile(99.99))
+                << ", \"max\": " << to_ns(histogram.max()) << "}}";
+            scaling_separator = ", ";
+        }
+        out << "]}";
+        separator = ",\n";
+    }
+    out << "\n  ]\n}\n";
+}
+
+auto Runner::write_csv(std::ostream& out) const -> void
+{
+    out << "name,threads,ops_per_sec,ops_per_sec_per_thread,samples,p50_ns,p99_ns,p99.9_ns,"
+           "p99.99_ns,max_ns\n";
+    for (const auto& result : m_results) {
+        for (const auto& scaling : result.scaling) {
+            const auto& histogram = scaling.histogram;
+            out << result.name << ',' << scaling.threads << ',' << scaling.ops_per_second << ','
+                << scaling.ops_per_second / static_cast<double>(scaling.threads) << ','
+                << histogram.count() << ',' << to_ns(histogram.percentile(50.0)) << ','
+                << to_ns(histogram.percentile(99.0)) << ',' << to_ns(histogram.percentile(99.9))
+                << ',' << to_ns(histogram.percentile(99.99)) << ',' << to_ns(histogram.max())
+                << '\n';
+        }
+    }
+}
+
+auto Runner::calibrate(const Body& body) const -> std::size_t
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr std::size_t MaxIterations = std::size_t{1} << 30U;
+
+    std::size_t iterations = 1;
+    for (;;) {
+        const auto start = Clock::now();
+        body(iterations);
+        const auto elapsed = Clock::now() - start;
+        if (elapsed >= m_options.min_time || iterations >= MaxIterations) {
+            return iterations;
+        }
+        // Jump close to the target once the measurement is meaningful
+        if (elapsed >= m_options.min_time / 10) {
+            const auto scale = std::chrono::duration<double>(m_options.min_time)
+                / std::chrono::duration<double>(elapsed);
+            return std::min(
+                MaxIterations,
+                static_cast<std::size_t>(std::ceil(static_cast<double>(iterations) * scale)));
+        }
+        iterations *= 2;
+    }
+}
+
+auto Runner::measure_scaling(
+    const Workload& workload,
+    std::size_t threads,
+    std::size_t iterations,
+    std::size_t samples) const -> Scaling
+{
+    Scaling result{threads, 0, {}};
+    // Throughput and latencies are measured in separate runs, so that
+    // the cycle counter does not slow down the throughput run
+    const auto elapsed = run_producers(
+        threads, [&workload, iterations](std::size_t /*unused*/) { workload.body(iterations); });
+    result.ops_per_second = static_cast<double>(threads * iterations) / elapsed.count();
+
+    std::vector<LatencyHistogram> histograms(threads);
+    std::ignore = run_producers(threads, [&workload, &histograms, samples](std::size_t index) {
+        workload.latency(samples, histograms[index]);
+    });
+    for (const auto& histogram : histograms) {
+        result.histogram.merge(histogram);
+    }
+    return result;
+}
+
+auto Runner::run_producers(
+    std::size_t threads, const std::function<void(std::size_t)>& producer) const
+    -> std::chrono::duration<double>
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::atomic<std::size_t> ready = 0;
+    std::atomic<bool> release = false;
+    Clock::time_point start;
+    {
+        std::vector<std::jthread> producers;
+        producers.reserve(threads);
+        for (std::size_t index = 0; index < threads; ++index) {
+            producers.emplace_back([this, &producer, &ready, &release, index]() {
+                if (m_options.pin) {
+                    pin_thread(m_cpus[index % m_cpus.size()]);
+                }
+                // Start all producers at once to maximize the contention
+                ready.fetch_add(1, std::memory_order_acq_rel);
+                while (!release.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                producer(index);
+            });
+        }
+        while (ready.load(std::memory_order_acquire) < threads) {
+            std::this_thread::yield();
+        }
+        start = Clock::now();
+        release.store(true, std::memory_order_release);
+    }
+    return Clock::now() - start;
+}
+
+auto Runner::to_ns(std::uint64_t ticks) const -> double
+{
+    return static_cast<double>(ticks) / m_ticks_per_ns;
+}
+
+} // namespace SlimLog::Bench
@@ -0,0 +1,260 @@
+/**
+ * @file runner.h
+ * @brief Contains declaration of the benchmark Runner class.
+ */
+
+#pragma once
+
+#include "cycle_counter.h"
+#include "perf_counters.h"
+
+#include <slimlog/util/histogram.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace SlimLog::Bench {
+
+/**
+ * @brief Benchmark options.
+ */
+struct Options {
+    std::string filter; ///< Substring of the scenario names to run, empty for all.
+    std::string output; ///< Path of the JSON report, empty for the standard output.
+    std::string csv; ///< Path of the CSV export of the scaling curves, empty for none.
+    std::size_t repetitions = 10; ///< Number of the measured repetitions.
+    std::chrono::milliseconds min_time{50}; ///< Minimal duration of one repetition.
+    std::size_t threads = 0; ///< Maximal number of the producers, zero for the number of cores.
+    std::size_t samples = 0; ///< Latency samples per producer, zero for one repetition worth.
+    bool scaling = true; ///< Measure the throughput and latencies with concurrent producers.
+    bool pin = true; ///< Pin the producer threads to separate cores.
+    bool check_allocations = false; ///< Fail if a scenario exceeds its allocation budget.
+    bool counters = true; ///< Read the hardware performance counters where available.
+    bool list = false; ///< List the scenarios instead of running them.
+};
+
+/**
+ * @brief Parses the command line options.
+ *
+ * @param argc Number of the arguments.
+ * @param argv Arguments.
+ * @return Parsed options.
+ * @throws std::invalid_argument if the arguments are malformed.
+ */
+auto parse_options(int argc, char* argv[]) -> Options; // NOLINT(*-avoid-c-arrays)
+
+/** @brief Histogram of the per-call latencies in cycle counter ticks. */
+using LatencyHistogram = Util::Histogram<>;
+
+/**
+ * @brief Measurements with a number of concurrent producers.
+ */
+struct Scaling {
+    std::size_t threads = 0; ///< Number of the producer threads.
+    double ops_per_second = 0; ///< Aggregate throughput of all producers.
+    LatencyHistogram histogram; ///< Per-call latencies of all producers.
+};
+
+/**
+ * @brief Measurements of one scenario.
+ */
+struct Result {
+    std::string name; ///< Scenario name.
+    std::size_t iterations = 0; ///< Number of the operations per repetition.
+    std::vector<double> ns_per_op; ///< Nanoseconds per operation of each repetition.
+    double allocations_per_op = 0; ///< Heap allocations per operation by the calling thread.
+    double allocation_budget = 0; ///< Allowed heap allocations per operation.
+    /** @brief Hardware performance counters per operation, empty if unavailable. */
+    std::vector<std::pair<std::string_view, double>> counters;
+    std::vector<Scaling> scaling; ///< Measurements by the number of producers.
+};
+
+/**
+ * @brief Benchmark runner.
+ *
+ * Each scenario consists of an untimed setup, which prepares the loggers and
+ * the input data, and of a timed operation. The number of operations per repetition
+ * is calibrated so that a repetition lasts at least the minimal time.
+ *
+ * Besides the single-threaded throughput, each scenario is swept over 1, 2, 4... producer
+ * threads (up to the limit of the scenario), each pinned to its own core, calling the
+ * operation concurrently. For every thread count the aggregate throughput is measured,
+ * and then the latency of each call is measured with the serializing cycle counter and
+ * recorded into a log-linear histogram, so that the contention shows up both in the
+ * scaling curve and in the tail percentiles.
+ *
+ * The heap allocations made by the calling thread during the timed repetitions are
+ * counted (see AllocationCounter) and compared against the allocation budget of the
+ * scenario, which is zero unless the scenario is expected to allocate. Where the kernel
+ * allows it, the hardware performance counters (see PerfCounters) are read over the same
+ * repetitions as well.
+ */
+class Runner final {
+public:
+    /** @brief Timed body performing the given number of operations. */
+    using Body = std::function<void(std::size_t)>;
+    /** @brief Timed body recording the latency of each of the given number of operations. */
+    using LatencyBody = std::function<void(std::size_t, LatencyHistogram&)>;
+
+    /**
+     * @brief Timed scenario bodies.
+     */
+    struct Workload {
+        Body body; ///< Throughput body.
+        LatencyBody latency; ///< Latency body.
+    };
+
+    /** @brief Untimed scenario setup returning the bodies. */
+    using Setup = std::function<Workload()>;
+
+    /**
+     * @brief Makes the workload repeating the operation.
+     *
+     * The operation is called concurrently by the producers during the scaling
+     * measurements, so it has to be thread-safe.
+     *
+     * @tparam Operation Invocable type accepting the operation index.
+     * @param operation Operation to measure.
+     * @return Workload.
+     */
+    template<typename Operation>
+    static auto workload(Operation operation) -> Workload
+    {
+        return {
+            [operation](std::size_t iterations) {
+                for (std::size_t i = 0; i < iterations; ++i) {
+                    operation(i);
+                }
+            },
+            [operation](std::size_t iterations, LatencyHistogram& histogram) {
+                for (std::size_t i = 0; i < iterations; ++i) {
+                    const auto start = CycleCounter::start();
+                    operation(i);
+                    histogram.record(CycleCounter::stop() - start);
+                }
+            }};
+    }
+
+    /**
+     * @brief Constructs a new Runner object.
+     *
+     * @param options Benchmark options.
+     */
+    explicit Runner(Options options);
+
+    /**
+     * @brief Registers the scenario.
+     *
+     * @param name Unique scenario name.
+     * @param setup Scenario setup.
+     * @param allocation_budget Allowed heap allocations per operation.
+     * @param max_threads Maximum number of the concurrent producers, zero for no limit.
+     */
+    auto add(
+        std::string name, Setup setup, double allocation_budget = 0, std::size_t max_threads = 0)
+        -> void;
+
+    /**
+     * @brief Runs the scenarios matching the filter.
+     *
+     * @param log Stream for the progress messages.
+     * @return \b true if all scenarios fit their allocation budgets or the check is disabled.
+     * @return \b false if any scenario allocated more than its budget.
+     */
+    [[nodiscard]] auto run(std::ostream& log) -> bool;
+
+    /**
+     * @brief Writes the scenario names.
+     *
+     * @param out Output stream.
+     */
+    auto list(std::ostream& out) const -> void;
+
+    /**
+     * @brief Writes the JSON report of the measurements.
+     *
+     * @param out Output stream.
+     */
+    auto write_json(std::ostream& out) const -> void;
+
+    /**
+     * @brief Writes the scaling curves as CSV, one row per scenario and thread count.
+     *
+     * @param out Output stream.
+     */
+    auto write_csv(std::ostream& out) const -> void;
+
+private:
+    /**
+     * @brief Registered scenario.
+     */
+    struct Scenario {
+        std::string name; ///< Scenario name.
+        Setup setup; ///< Scenario setup returning the workload.
+        double allocation_budget; ///< Allowed heap allocations per operation.
+        std::size_t max_threads; ///< Maximum number of the producers, zero for no limit.
+    };
+
+    /**
+     * @brief Finds the number of operations lasting at least the minimal time.
+     *
+     * @param body Scenario body.
+     * @return Number of operations per repetition.
+     */
+    auto calibrate(const Body& body) const -> std::size_t;
+
+    /**
+     * @brief Measures the throughput and latencies with the given number of producers.
+     *
+     * @param workload Scenario bodies.
+     * @param threads Number of the producer threads.
+     * @param iterations Number of the throughput operations per producer.
+     * @param samples Number of the latency samples per producer.
+     * @return Measurements of all producers.
+     */
+    [[nodiscard]] auto measure_scaling(
+        const Workload& workload,
+        std::size_t threads,
+        std::size_t iterations,
+        std::size_t samples) const -> Scaling;
+
+    /**
+     * @brief Runs the producers concurrently.
+     *
+     * Each producer is pinned to the next allowed core (if pinning is enabled),
+     * and all of them are released at once after they have started.
+     *
+     * @param threads Number of the producer threads.
+     * @param producer Function called with the producer index.
+     * @return Time from the release of the producers until the last one has finished.
+     */
+    [[nodiscard]] auto run_producers(
+        std::size_t threads, const std::function<void(std::size_t)>& producer) const
+        -> std::chrono::duration<double>;
+
+    /**
+     * @brief Converts the cycle counter ticks to nanoseconds.
+     *
+     * @param ticks Number of ticks.
+     * @return Nanoseconds.
+     */
+    [[nodiscard]] auto to_ns(std::uint64_t ticks) const -> double;
+
+    Options m_options;
+    double m_ticks_per_ns = 1.0;
+    std::uint64_t m_counter_overhead = 0;
+    std::vector<unsigned> m_cpus;
+    std::optional<PerfCounters> m_counters;
+    std::vector<Scenario> m_scenarios;
+    std::vector<Result> m_results;
+};
+
+} // namespace SlimLog::Bench
@@ -0,0 +1,318 @@
+/**
+ * @file backtrace.h
+ * @brief Contains the definition of the Backtrace class.
+ */
+
+#pragma once
+
+#include "slimlog/format.h"
+#include "slimlog/level.h"
+#include "slimlog/location.h"
+#include "slimlog/record.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace SlimLog {
+
+/**
+ * @brief Default number of messages kept in the per-thread backtrace.
+ */
+static constexpr auto DefaultBacktraceSize = 32U;
+
+/**
+ * @brief Per-thread backtrace of suppressed log messages.
+ *
+ * Keeps the last messages which did not pass the logger level, so that they can be emitted
+ * later as a context for an error reported by the same thread. Every thread owns a separate
+ * ring shared by all loggers of the same type, entries are tagged with the logger ID.
+ *
+ * Format arguments of arithmetic and string types (`std::basic_string`, `std::basic_string_view`
+ * and C strings of the message character type) are copied into the entry along with the format
+ * string and formatted only on replay. The characters of the string arguments go to a per-entry
+ * buffer which keeps its capacity when the entry is reused, so capturing does not allocate
+ * once the ring has warmed up. Messages with arguments of other types, or with too many
+ * arguments, are formatted immediately.
+ *
+ * @tparam Char Character type for log messages.
+ * @tparam BufferSize Size of the buffer used for formatting.
+ * @tparam Allocator Allocator type for the formatting buffer.
+ * @tparam Capacity Maximum number of messages per thread.
+ */
+template<
+    typename Char,
+    std::size_t BufferSize,
+    typename Allocator,
+    std::size_t Capacity = DefaultBacktraceSize>
+class Backtrace final {
+public:
+    /** @brief Buffer type used for log message formatting. */
+    using FormatBufferType = FormatBuffer<Char, BufferSize, Allocator>;
+    /** @brief String view type for log messages. */
+    using StringViewType = std::basic_string_view<Char>;
+
+    /**
+     * @brief Gets the backtrace of the calling thread.
+     *
+     * @return Reference to the thread-local backtrace.
+     */
+    static auto local() -> Backtrace&
+    {
+        thread_local Backtrace backtrace;
+        return backtrace;
+    }
+
+    /**
+     * @brief Generates a unique ID for the entries owner.
+     *
+     * @return Non-zero owner ID.
+     */
+    static auto next_id() -> std::uint64_t
+    {
+        static std::atomic<std::uint64_t> counter = 0;
+        return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    /**
+     * @brief Checks if the backtrace has no pending entries.
+     *
+     * @return \b true if there are no entries.
+     */
+    [[nodiscard]] auto empty() const noexcept -> bool
+    {
+        return m_size == 0;
+    }
+
+    /**
+     * @brief Stores a formatted message.
+     *
+     * @tparam Args Format argument types.
+     * @param owner Owner ID.
+     * @param level Log level.
+     * @param location Caller location.
+     * @param time Capture time.
+     * @param fmt Format string.
+     * @param args Format arguments.
+     */
+    template<typename... Args>
+    auto push(
+        std::uint64_t owner,
+        Level level,
+        Location location,
+        RecordTime time,
+        FormatString<Char, std::type_identity_t<Args>...> fmt,
+        Args&&... args) -> void
+    {
+        auto& entry = next_entry(owner, level, location, time);
+        if constexpr (
+            (Deferrable<Args> && ...) && sizeof(std::tuple<Stored<Args>...>) <= StorageSize) {
+            using Storage = std::tuple<Stored<Args>...>;
+#ifdef SLIMLOG_FMTLIB
+            const auto view = static_cast<fmt::basic_string_view<Char>>(fmt);
+            entry.fmt = StringViewType(view.data(), view.size());
+#else
+            entry.fmt = fmt.get();
+#endif
+            new (entry.storage.data()) Storage(capture(entry, std::forward<Args>(args))...);
+            entry.format = [](FormatBufferType& buffer, const Entry& entry) {
+                std::apply(
+                    [&buffer, &entry](const auto&... args) {
+                        buffer.vformat(
+                            entry.fmt,
+                            FormatBufferType::make_format_args(restore(entry, args)...));
+                    },
+                    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+                    *std::launder(reinterpret_cast<const Storage*>(entry.storage.data())));
+            };
+        } else {
+            FormatBufferType buffer;
+            buffer.format(std::move(fmt), std::forward<Args>(args)...);
+            entry.text.assign(buffer.data(), buffer.size());
+        }
+    }
+
+    /**
+     * @brief Stores a plain message.
+     *
+     * @param owner Owner ID.
+     * @param level Log level.
+     * @param location Caller location.
+     * @param time Capture time.
+     * @param message Log message.
+     */
+    auto push(
+        std::uint64_t owner,
+        Level level,
+        Location location,
+        RecordTime time,
+        StringViewType message) -> void
+    {
+        next_entry(owner, level, location, time).text.assign(message);
+    }
+
+    /**
+     * @brief Replays and removes all entries of the owner, from the oldest to the newest.
+     *
+     * @tparam T Callback type.
+     * @param owner Owner ID.
+     * @param callback Callback accepting level, location, time and message of the entry.
+     */
+    template<typename T>
+    auto replay(std::uint64_t owner, T&& callback) -> void
+    {
+        FormatBufferType buffer;
+        auto index = (m_next + Capacity - m_size) % Capacity;
+        for (std::size_t i = 0; i < m_size; ++i, index = (index + 1) % Capacity) {
+            auto& entry = m_entries[index];
+            if (entry.owner != owner) {
+                continue;
+            }
+            entry.owner = 0;
+
+            StringViewType message = entry.text;
+            if (entry.format) {
+                buffer.clear();
+                entry.format(buffer, entry);
+                message = StringViewType(buffer.data(), buffer.size());
+            }
+            callback(entry.level, entry.location, entry.time, message);
+        }
+
+        // Drop the leading entries which have been replayed
+        while (m_size > 0 && m_entries[(m_next + Capacity - m_size) % Capacity].owner == 0) {
+            --m_size;
+        }
+    }
+
+private:
+    static constexpr std::size_t StorageSize = 64;
+
+    /**
+     * @brief String argument copied into the entry text.
+     */
+    struct StringRef {
+        std::size_t offset; ///< Offset of the first character in the entry text.
+        std::size_t size; ///< Number of characters.
+    };
+
+    /**
+     * @brief Checks if the argument is a string of the message character type.
+     *
+     * @tparam T Argument type.
+     */
+    template<typename T>
+    static constexpr bool IsString = std::is_same_v<std::decay_t<T>, std::basic_string<Char>>
+        || std::is_same_v<std::decay_t<T>, StringViewType>
+        || std::is_same_v<std::decay_t<T>, const Char*> || std::is_same_v<std::decay_t<T>, Char*>;
+
+    /**
+     * @brief Checks if the argument can be stored for deferred formatting.
+     *
+     * @tparam T Argument type.
+     */
+    template<typename T>
+    static constexpr bool Deferrable = std::is_arithmetic_v<std::remove_cvref_t<T>> || IsString<T>;
+
+    /**
+     * @brief Type of the argument stored for deferred formatting.
+     *
+     * @tparam T Argument type.
+     */
+    template<typename T>
+    using Stored = std::conditional_t<IsString<T>, StringRef, std::remove_cvref_t<T>>;
+
+    /**
+     * @brief Backtrace entry.
+     */
+    struct Entry {
+        std::uint64_t owner = {}; ///< Owner ID (zero if consumed).
+        Level level = {}; ///< Log level.
+        Location location = {}; ///< Caller location.
+        RecordTime time = {}; ///< Capture time.
+        void (*format)(FormatBufferType&, const Entry&) = {}; ///< Deferred formatting function.
+        StringViewType fmt; ///< Format string for deferred formatting.
+        alignas(std::max_align_t) std::array<unsigned char, StorageSize> storage = {}; ///< Args.
+        std::basic_string<Char> text; ///< Message formatted at capture time or string args.
+    };
+
+    /**
+     * @brief Stores the argument for deferred formatting.
+     *
+     * @tparam T Argument type.
+     * @param entry Entry receiving the string characters.
+     * @param arg Format argument.
+     * @return Argument value or reference to its characters in the entry text.
+     */
+    template<typename T>
+    static auto capture(Entry& entry, T&& arg) -> Stored<T>
+    {
+        if constexpr (IsString<T>) {
+            const StringViewType view(arg);
+            const StringRef result{entry.text.size(), view.size()};
+            entry.text.append(view);
+            return result;
+        } else {
+            return std::forward<T>(arg);
+        }
+    }
+
+    /**
+     * @brief Restores the argument stored for deferred formatting.
+     *
+     * @tparam T Stored argument type.
+     * @param entry Entry holding the string characters.
+     * @param arg Stored argument.
+     * @return Argument value or view of its characters.
+     */
+    template<typename T>
+    static auto restore(const Entry& entry, const T& arg) -> decltype(auto)
+    {
+        if constexpr (std::is_same_v<T, StringRef>) {
+            return StringViewType(entry.text).substr(arg.offset, arg.size);
+        } else {
+            return (arg);
+        }
+    }
+
+    /**
+     * @brief Takes the next entry, overwriting the oldest one if the ring is full.
+     *
+     * @param owner Owner ID.
+     * @param level Log level.
+     * @param location Caller location.
+     * @param time Capture time.
+     * @return Reference to the entry.
+     */
+    auto next_entry(std::uint64_t owner, Level level, Location location, RecordTime time)
+        -> Entry&
+    {
+        auto& entry = m_entries[m_next];
+        m_next = (m_next + 1) % Capacity;
+        if (m_size < Capacity) {
+            ++m_size;
+        }
+
+        entry.owner = owner;
+        entry.level = level;
+        entry.location = location;
+        entry.time = time;
+        entry.format = nullptr;
+        entry.text.clear();
+        return entry;
+    }
+
+    std::array<Entry, Capacity> m_entries;
+    std::size_t m_next = 0;
+    std::size_t m_size = 0;
+};
+
+} // namespace SlimLog
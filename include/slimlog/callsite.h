@@ -0,0 +1,280 @@
+/**
+ * @file callsite.h
+ * @brief Contains the definition of the CallSite class.
+ */
+
+#pragma once
+
+#include "slimlog/location.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SlimLog {
+
+/** @cond */
+namespace Detail {
+/**
+ * @brief Matches the text against the glob pattern with `*` and `?` wildcards.
+ *
+ * @param pattern Glob pattern.
+ * @param text Text to match.
+ * @return \b true if the whole text matches the pattern.
+ */
+constexpr auto glob_match(std::string_view pattern, std::string_view text) noexcept -> bool
+{
+    std::size_t pattern_pos = 0;
+    std::size_t text_pos = 0;
+    // Position after the last star and the text position it has been matched with
+    std::size_t star_pos = std::string_view::npos;
+    std::size_t star_text_pos = 0;
+
+    while (text_pos < text.size()) {
+        if (pattern_pos < pattern.size()
+            && (pattern[pattern_pos] == '?' || pattern[pattern_pos] == text[text_pos])) {
+            ++pattern_pos;
+            ++text_pos;
+        } else if (pattern_pos < pattern.size() && pattern[pattern_pos] == '*') {
+            star_pos = ++pattern_pos;
+            star_text_pos = text_pos;
+        } else if (star_pos != std::string_view::npos) {
+            // Let the last star swallow one more character
+            pattern_pos = star_pos;
+            text_pos = ++star_text_pos;
+        } else {
+            return false;
+        }
+    }
+    while (pattern_pos < pattern.size() && pattern[pattern_pos] == '*') {
+        ++pattern_pos;
+    }
+    return pattern_pos == pattern.size();
+}
+} // namespace Detail
+/** @endcond */
+
+/**
+ * @brief Runtime switch of a single logging call site.
+ *
+ * Implements the dynamic debug approach: each call site declares a static descriptor
+ * (see `SLIMLOG_DEBUG` and `SLIMLOG_TRACE` macros), which registers itself in a global
+ * list the first time it executes. The sites can be listed and switched on by file name
+ * glob and function name at runtime, so that tracing can be turned on for one function
+ * in production while the other sites cost a single predicted-not-taken branch.
+ *
+ * The descriptor is constant-initialized, its switch is one atomic byte. Registered sites
+ * form a lock-free list which is never shrunk, as the descriptors have static storage.
+ * Rules passed to set_enabled() are remembered and applied to the sites registered later.
+ *
+ * Usage example:
+ * ```cpp
+ * Log::CallSite::set_enabled("parser.cpp", "*", true);
+ * Log::CallSite::for_each([](const Log::CallSite& site) {
+ *     std::printf("%s:%d %s\n", site.location().file_name(), site.location().line(),
+ *                 site.enabled() ? "on" : "off");
+ * });
+ * ```
+ */
+class CallSite final {
+public:
+    /**
+     * @brief Constructs a new CallSite object.
+     *
+     * @param location Call site location.
+     */
+    constexpr explicit CallSite(Location location) noexcept
+        : m_location(location)
+    {
+    }
+
+    CallSite(CallSite const&) = delete;
+    CallSite(CallSite&&) = delete;
+    auto operator=(CallSite const&) -> CallSite& = delete;
+    auto operator=(CallSite&&) -> CallSite& = delete;
+
+    /** @brief Destroys the CallSite object. */
+    ~CallSite() = default;
+
+    /**
+     * @brief Checks if the call site is switched on.
+     *
+     * Registers the site on the first call.
+     *
+     * @return \b true if the call site is switched on.
+     */
+    [[nodiscard]] auto enabled() -> bool
+    {
+        const auto state = m_state.load(std::memory_order_relaxed);
+        if (state == State::Disabled) [[likely]] {
+            return false;
+        }
+        return state == State::Enabled || register_site();
+    }
+
+    /**
+     * @brief Switches the call site on or off.
+     *
+     * @param enabled Switch state.
+     */
+    auto set_enabled(bool enabled) noexcept -> void
+    {
+        m_state.store(enabled ? State::Enabled : State::Disabled, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Gets the call site location.
+     *
+     * @return Call site location.
+     */
+    [[nodiscard]] constexpr auto location() const noexcept -> const Location&
+    {
+        return m_location;
+    }
+
+    /**
+     * @brief Switches the matching call sites on or off.
+     *
+     * Applies to the registered sites and to the sites registered later,
+     * the rule added last wins.
+     *
+     * @param file Glob pattern of the file name (e.g., `"net_*.cpp"`).
+     * @param function Glob pattern of the function name, `"*"` for any function.
+     * @param enabled Switch state.
+     * @return Number of the registered sites matched.
+     */
+    static auto set_enabled(std::string_view file, std::string_view function, bool enabled)
+        -> std::size_t
+    {
+        auto& registry = CallSite::registry();
+        const std::lock_guard lock(registry.mutex);
+        registry.rules.push_back({std::string(file), std::string(function), enabled});
+
+        std::size_t matched = 0;
+        for (auto* site = registry.head.load(std::memory_order_relaxed); site != nullptr;
+             site = site->m_next) {
+            if (registry.rules.back().matches(site->m_location)) {
+                site->set_enabled(enabled);
+                ++matched;
+            }
+        }
+        return matched;
+    }
+
+    /**
+     * @brief Switches all call sites off and forgets the rules.
+     */
+    static auto reset() -> void
+    {
+        auto& registry = CallSite::registry();
+        const std::lock_guard lock(registry.mutex);
+        registry.rules.clear();
+        for (auto* site = registry.head.load(std::memory_order_relaxed); site != nullptr;
+             site = site->m_next) {
+            site->set_enabled(false);
+        }
+    }
+
+    /**
+     * @brief Calls the visitor for each registered call site.
+     *
+     * Does not take locks, sites registered concurrently may be skipped.
+     *
+     * @tparam Visitor Invocable type accepting the call site reference.
+     * @param visitor Visitor to call.
+     */
+    template<typename Visitor>
+    static auto for_each(Visitor&& visitor) -> void
+    {
+        for (auto* site = registry().head.load(std::memory_order_acquire); site != nullptr;
+             site = site->m_next) {
+            visitor(*site);
+        }
+    }
+
+private:
+    /**
+     * @brief Call site state.
+     */
+    enum class State : std::uint8_t {
+        Disabled, ///< Registered and switched off.
+        Enabled, ///< Registered and switched on.
+        Unregistered ///< Has not been executed yet.
+    };
+
+    /**
+     * @brief Switching rule.
+     */
+    struct Rule {
+        std::string file; ///< File name glob.
+        std::string function; ///< Function name glob.
+        bool enabled; ///< Switch state.
+
+        /**
+         * @brief Checks if the rule applies to the location.
+         *
+         * @param location Call site location.
+         * @return \b true if both globs match.
+         */
+        [[nodiscard]] auto matches(const Location& location) const noexcept -> bool
+        {
+            return Detail::glob_match(file, location.file_name())
+                && Detail::glob_match(function, location.function_name());
+        }
+    };
+
+    /**
+     * @brief Registered call sites and rules.
+     */
+    struct Registry {
+        std::atomic<CallSite*> head = nullptr; ///< Most recently registered site.
+        std::vector<Rule> rules; ///< Rules in the order of addition.
+        std::mutex mutex; ///< Serializes registration and rule changes.
+    };
+
+    /**
+     * @brief Gets the global registry.
+     *
+     * @return Registry reference.
+     */
+    static auto registry() -> Registry&
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    /**
+     * @brief Registers the call site and applies the rules to it.
+     *
+     * @return \b true if the call site is switched on.
+     */
+    auto register_site() -> bool
+    {
+        auto& registry = CallSite::registry();
+        const std::lock_guard lock(registry.mutex);
+        // Another thread could have registered the site meanwhile
+        auto state = m_state.load(std::memory_order_relaxed);
+        if (state == State::Unregistered) {
+            state = State::Disabled;
+            for (const auto& rule : registry.rules) {
+                if (rule.matches(m_location)) {
+                    state = rule.enabled ? State::Enabled : State::Disabled;
+                }
+            }
+            m_next = registry.head.load(std::memory_order_relaxed);
+            registry.head.store(this, std::memory_order_release);
+            m_state.store(state, std::memory_order_relaxed);
+        }
+        return state == State::Enabled;
+    }
+
+    Location m_location;
+    std::atomic<State> m_state = State::Unregistered;
+    CallSite* m_next = nullptr;
+};
+
+} // namespace SlimLog
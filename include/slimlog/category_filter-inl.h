@@ -0,0 +1,136 @@
+/**
+ * @file category_filter-inl.h
+ * @brief Contains definition of CategoryFilter class.
+ */
+
+#pragma once
+
+// IWYU pragma: private, include "slimlog/category_filter.h"
+
+#include "slimlog/category_filter.h" // IWYU pragma: associated
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+
+namespace SlimLog {
+
+template<typename Char>
+CategoryFilter<Char>::CategoryFilter(StringViewType rules, Level default_level)
+    : m_default_level(default_level)
+    , m_trie(compile(rules))
+{
+}
+
+template<typename Char>
+CategoryFilter<Char>::CategoryFilter(CategoryFilter const& filter)
+    : m_default_level(filter.m_default_level)
+    , m_trie(std::make_unique<const Trie>(*filter.m_trie.read()))
+{
+}
+
+template<typename Char>
+auto CategoryFilter<Char>::set_rules(StringViewType rules) -> void
+{
+    m_trie.update(compile(rules));
+}
+
+template<typename Char>
+auto CategoryFilter<Char>::level(StringViewType category) const noexcept -> Level
+{
+    const auto guard = m_trie.read();
+    const auto& trie = *guard;
+    Level level = *trie.front().level;
+
+    std::uint32_t node = 0;
+    for (std::size_t pos = 0; pos <= category.size(); ++pos) {
+        // Rules match only at the segment boundaries
+        const bool boundary = pos == category.size() || category[pos] == Char{'.'};
+        if (boundary && trie[node].level) {
+            level = *trie[node].level;
+        }
+        if (pos == category.size()) {
+            break;
+        }
+
+        const auto& children = trie[node].children;
+        const auto child = std::lower_bound(
+            children.begin(), children.end(), category[pos], [](const auto& item, Char chr) {
+                return item.first < chr;
+            });
+        if (child == children.end() || child->first != category[pos]) {
+            break;
+        }
+        node = child->second;
+    }
+    return level;
+}
+
+template<typename Char>
+auto CategoryFilter<Char>::compile(StringViewType rules) const -> std::unique_ptr<const Trie>
+{
+    auto trie = std::make_unique<Trie>(1);
+    trie->front().level = m_default_level;
+
+    const auto is_separator = [](Char chr) {
+        return chr == Char{','} || chr == Char{';'} || chr == Char{'\n'} || chr == Char{'\r'};
+    };
+    const auto trim = [](StringViewType value) {
+        const auto is_space = [](Char chr) { return chr == Char{' '} || chr == Char{'\t'}; };
+        while (!value.empty() && is_space(value.front())) {
+            value.remove_prefix(1);
+        }
+        while (!value.empty() && is_space(value.back())) {
+            value.remove_suffix(1);
+        }
+        return value;
+    };
+
+    auto pos = rules.begin();
+    while (pos != rules.end()) {
+        const auto end = std::find_if(pos, rules.end(), is_separator);
+        const auto rule = trim(StringViewType{pos, end});
+        pos = end == rules.end() ? end : std::next(end);
+        if (rule.empty()) {
+            continue;
+        }
+
+        const auto equal = rule.rfind(Char{'='});
+        StringViewType category
+            = equal == StringViewType::npos ? StringViewType{} : trim(rule.substr(0, equal));
+        const auto level = parse_level<Char>(
+            equal == StringViewType::npos ? rule : trim(rule.substr(equal + 1)));
+        if (!level) {
+            throw std::invalid_argument("CategoryFilter: unknown level in rule");
+        }
+        if (category.size() == 1 && category.front() == Char{'*'}) {
+            category = {};
+        }
+        if (!category.empty() && (category.front() == Char{'.'} || category.back() == Char{'.'})) {
+            throw std::invalid_argument("CategoryFilter: malformed category in rule");
+        }
+
+        std::uint32_t node = 0;
+        for (const auto chr : category) {
+            auto& children = (*trie)[node].children;
+            auto child = std::lower_bound(
+                children.begin(), children.end(), chr, [](const auto& item, Char value) {
+                    return item.first < value;
+                });
+            if (child == children.end() || child->first != chr) {
+                const auto next = static_cast<std::uint32_t>(trie->size());
+                children.emplace(child, chr, next);
+                trie->emplace_back();
+                node = next;
+            } else {
+                node = child->second;
+            }
+        }
+        (*trie)[node].level = level;
+    }
+
+    return trie;
+}
+
+} // namespace SlimLog
@@ -0,0 +1,119 @@
+/**
+ * @file category_filter.h
+ * @brief Contains declaration of CategoryFilter class.
+ */
+
+#pragma once
+
+#include "slimlog/level.h"
+#include "slimlog/util/rcu.h"
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace SlimLog {
+
+/**
+ * @brief Category level filter.
+ *
+ * Maps dotted logger categories to logging levels according to a list of rules,
+ * such as `"info,net.http.client=debug,db=warning"`. A rule applies to the category
+ * itself and to all its subcategories (`"net"` matches `"net"` and `"net.http"`,
+ * but not `"network"`), the most specific rule wins. A rule without a category sets
+ * the default level.
+ *
+ * The rules are compiled into a character trie, so the level lookup costs a single
+ * pass over the category string. The compiled trie is immutable and published with
+ * one atomic pointer swap (see Util::RcuPointer), so lookups may run concurrently
+ * with set_rules().
+ * The filter is applied to a logger hierarchy with Logger::set_levels(), which makes
+ * the message-time level check a plain comparison.
+ *
+ * Usage example:
+ * ```cpp
+ * Log::CategoryFilter<char> filter("warning,net.http.client=debug,db=error");
+ * root.set_levels(filter);
+ * ```
+ *
+ * @tparam Char Character type for the category.
+ */
+template<typename Char>
+class CategoryFilter {
+public:
+    /** @brief String view type for categories and rules. */
+    using StringViewType = std::basic_string_view<Char>;
+
+    /**
+     * @brief Constructs a new CategoryFilter object.
+     *
+     * @param rules Comma, semicolon or newline separated list of `category=level` rules.
+     * @param default_level Level of the categories which match no rule.
+     * @throws std::invalid_argument if the rules are malformed.
+     */
+    explicit CategoryFilter(StringViewType rules = {}, Level default_level = Level::Info);
+
+    /**
+     * @brief Copy constructor.
+     *
+     * Takes a snapshot of the current rules.
+     *
+     * @param filter Category filter to copy.
+     */
+    CategoryFilter(CategoryFilter const& filter);
+    CategoryFilter(CategoryFilter&&) = delete;
+    auto operator=(CategoryFilter const&) -> CategoryFilter& = delete;
+    auto operator=(CategoryFilter&&) -> CategoryFilter& = delete;
+
+    /** @brief Destroys the CategoryFilter object. */
+    ~CategoryFilter() = default;
+
+    /**
+     * @brief Replaces the rules.
+     *
+     * The previous rules remain in effect if the new ones are malformed.
+     *
+     * @param rules Comma, semicolon or newline separated list of `category=level` rules.
+     * @throws std::invalid_argument if the rules are malformed.
+     */
+    auto set_rules(StringViewType rules) -> void;
+
+    /**
+     * @brief Gets the logging level of the category.
+     *
+     * @param category Logger category.
+     * @return Level set by the most specific matching rule or the default level.
+     */
+    [[nodiscard]] auto level(StringViewType category) const noexcept -> Level;
+
+private:
+    /**
+     * @brief Trie node.
+     */
+    struct Node {
+        std::vector<std::pair<Char, std::uint32_t>> children; ///< Sorted child node indices.
+        std::optional<Level> level; ///< Level of the rule ending at this node.
+    };
+
+    /** @brief Compiled rules, the first node is the root. */
+    using Trie = std::vector<Node>;
+
+    /**
+     * @brief Compiles the rules into a trie.
+     *
+     * @param rules List of rules.
+     * @return Compiled trie.
+     */
+    auto compile(StringViewType rules) const -> std::unique_ptr<const Trie>;
+
+    Level m_default_level;
+    Util::RcuPointer<const Trie> m_trie;
+};
+} // namespace SlimLog
+
+#ifdef SLIMLOG_HEADER_ONLY
+#include "slimlog/category_filter-inl.h" // IWYU pragma: keep
+#endif
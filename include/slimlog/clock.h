@@ -0,0 +1,664 @@
+/**
+ * @file clock.h
+ * @brief Contains the clock policies providing the record timestamps and thread IDs.
+ */
+
+#pragma once
+
+#include "slimlog/record.h"
+#include "slimlog/util/os.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <utility>
+
+namespace SlimLog {
+
+/**
+ * @brief Clock policy reading the wall clock in the local time zone.
+ *
+ * Uses the coarse real-time clock where available and converts it to the local time
+ * once per second and thread (see Util::OS::local_time()).
+ */
+struct RealtimeClock final {
+    /**
+     * @brief Gets the current time.
+     *
+     * @return Local time and nanoseconds part.
+     */
+    [[nodiscard]] static auto now() -> RecordTime
+    {
+        const auto [local, nsec] = Util::OS::local_time();
+        return {local, nsec};
+    }
+
+    /**
+     * @brief Gets the current thread ID.
+     *
+     * @return Thread ID.
+     */
+    [[nodiscard]] static auto thread_id() noexcept -> std::size_t
+    {
+        return Util::OS::thread_id();
+    }
+};
+
+/**
+ * @brief Clock policy reading the wall clock in UTC.
+ *
+ * Reads the same coarse real-time clock as RealtimeClock, but skips the time zone
+ * conversion altogether, so the second rollovers cost nothing.
+ */
+struct UtcClock final {
+    /**
+     * @brief Gets the current time.
+     *
+     * @return UTC time and nanoseconds part.
+     */
+    [[nodiscard]] static auto now() noexcept -> RecordTime
+    {
+        const auto curtime = Util::OS::coarse_time();
+        return {
+            std::chrono::sys_seconds(std::chrono::seconds(curtime.tv_sec)),
+            static_cast<std::size_t>(curtime.tv_nsec)};
+    }
+
+    /**
+     * @brief Gets the current thread ID.
+     *
+     * @return Thread ID.
+     */
+    [[nodiscard]] static auto thread_id() noexcept -> std::size_t
+    {
+        return Util::OS::thread_id();
+    }
+};
+
+/**
+ * @brief Clock policy reading the wall clock in the local time zone with a cached offset.
+ *
+ * Reads the same coarse real-time clock as RealtimeClock, but converts it to the local
+ * time by adding the time zone offset instead of calling `localtime_r()` on each second
+ * rollover, which may take the time zone lock of the C library on all threads at once.
+ * Each thread caches the offset with the interval where it holds: the neighbouring daylight
+ * saving time transitions are located with a binary search within a week of the current
+ * time, so the offset is recomputed at the transitions and weekly otherwise. The calendar
+ * fields are then computed arithmetically by the time formatter.
+ *
+ * Changes of the time zone settings (e.g. the `TZ` variable) take effect when the cached
+ * interval expires. Two transitions less than a week apart may be missed.
+ */
+struct OffsetClock final {
+    /**
+     * @brief Gets the current time.
+     *
+     * @return Local time and nanoseconds part.
+     */
+    [[nodiscard]] static auto now() -> RecordTime
+    {
+        const auto curtime = Util::OS::coarse_time();
+        return {
+            std::chrono::sys_seconds(std::chrono::seconds(curtime.tv_sec) + offset(curtime.tv_sec)),
+            static_cast<std::size_t>(curtime.tv_nsec)};
+    }
+
+    /**
+     * @brief Gets the current thread ID.
+     *
+     * @return Thread ID.
+     */
+    [[nodiscard]] static auto thread_id() noexcept -> std::size_t
+    {
+        return Util::OS::thread_id();
+    }
+
+    /**
+     * @brief Gets the offset of the local time zone.
+     *
+     * @param time Seconds since the Unix epoch.
+     * @return Difference between the local time and UTC.
+     */
+    [[nodiscard]] static auto offset(std::time_t time) -> std::chrono::seconds
+    {
+        static thread_local Interval cached;
+        if (time < cached.from || time >= cached.until) [[unlikely]] {
+            cached = find_interval(time);
+        }
+        return cached.offset;
+    }
+
+private:
+    /** @brief Distance to look for the time zone transitions at. */
+    static constexpr std::time_t Horizon = std::chrono::seconds(std::chrono::weeks(1)).count();
+
+    /**
+     * @brief Time interval with the constant time zone offset.
+     */
+    struct Interval {
+        std::time_t from = 0; ///< First second of the interval.
+        std::time_t until = 0; ///< Second after the end of the interval.
+        std::chrono::seconds offset{0}; ///< Time zone offset.
+    };
+
+    /**
+     * @brief Computes the offset of the local time zone with the C library.
+     *
+     * @param time Seconds since the Unix epoch.
+     * @return Difference between the local time and UTC.
+     */
+    static auto zone_offset(std::time_t time) -> std::chrono::seconds
+    {
+        return Util::OS::to_local(time).time_since_epoch() - std::chrono::seconds(time);
+    }
+
+    /**
+     * @brief Finds the interval around the time where the time zone offset is the same.
+     *
+     * @param time Seconds since the Unix epoch.
+     * @return Interval of at most a week in each direction from the time.
+     */
+    static auto find_interval(std::time_t time) -> Interval
+    {
+        Interval interval{time - Horizon, time + Horizon, zone_offset(time)};
+
+        // Each search keeps the time with the current offset at `same`
+        // and the time with another offset at `other`
+        if (zone_offset(interval.from) != interval.offset) {
+            std::time_t other = interval.from;
+            std::time_t same = time;
+            while (same - other > 1) {
+                const auto middle = other + (same - other) / 2;
+                (zone_offset(middle) == interval.offset ? same : other) = middle;
+            }
+            interval.from = same;
+        }
+        if (zone_offset(interval.until - 1) != interval.offset) {
+            std::time_t same = time;
+            std::time_t other = interval.until - 1;
+            while (other - same > 1) {
+                const auto middle = same + (other - same) / 2;
+                (zone_offset(middle) == interval.offset ? same : other) = middle;
+            }
+            interval.until = other;
+        }
+        return interval;
+    }
+};
+
+/**
+ * @brief Clock policy reading the monotonic clock.
+ *
+ * The time is counted from an unspecified point (usually the system boot) and
+ * is not converted to the local time zone, so it never jumps and costs no time
+ * zone lookups. Suitable for measuring the intervals between records.
+ */
+struct MonotonicClock final {
+    /**
+     * @brief Gets the current time.
+     *
+     * @return Time since the clock epoch and nanoseconds part.
+     */
+    [[nodiscard]] static auto now() noexcept -> RecordTime
+    {
+        const auto time = std::chrono::steady_clock::now().time_since_epoch();
+        const auto seconds = std::chrono::floor<std::chrono::seconds>(time);
+        return {
+            std::chrono::sys_seconds(seconds),
+            static_cast<std::size_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(time - seconds).count())};
+    }
+
+    /**
+     * @brief Gets the current thread ID.
+     *
+     * @return Thread ID.
+     */
+    [[nodiscard]] static auto thread_id() noexcept -> std::size_t
+    {
+        return Util::OS::thread_id();
+    }
+};
+
+/**
+ * @brief Clock policy returning the time and thread ID set by the application.
+ *
+ * The time stands still until it is changed with set() or advance(), which makes
+ * the record timestamps reproducible: benchmarks can exclude the clock from the
+ * measurements or force the time fields to be formatted again on every record,
+ * and tests can compare the output verbatim. The state is shared by all loggers
+ * using this clock and may be changed concurrently with logging.
+ *
+ * Usage example:
+ * ```cpp
+ * using Clock = Log::ManualClock;
+ * Log::Logger<std::string_view, char, Log::DefaultThreadingPolicy, Log::DefaultBufferSize,
+ *             std::allocator<char>, Clock> log("main");
+ * Clock::set(std::chrono::sys_days{std::chrono::January / 1 / 2024});
+ * Clock::set_thread_id(1);
+ * log.info("Hello"); // Always logged at 2024-01-01 00:00:00 by thread 1
+ * Clock::advance(std::chrono::seconds(1));
+ * ```
+ */
+class ManualClock final {
+public:
+    /** @brief Time point type with nanosecond precision. */
+    using TimePoint = std::chrono::sys_time<std::chrono::nanoseconds>;
+
+    /**
+     * @brief Gets the time set last.
+     *
+     * @return Time and nanoseconds part.
+     */
+    [[nodiscard]] static auto now() noexcept -> RecordTime
+    {
+        const std::chrono::nanoseconds time{time_storage().load(std::memory_order_relaxed)};
+        const auto seconds = std::chrono::floor<std::chrono::seconds>(time);
+        return {
+            std::chrono::sys_seconds(seconds),
+            static_cast<std::size_t>((time - seconds).count())};
+    }
+
+    /**
+     * @brief Gets the thread ID set last.
+     *
+     * @return Thread ID set by set_thread_id(), or the actual one if none is set.
+     */
+    [[nodiscard]] static auto thread_id() noexcept -> std::size_t
+    {
+        const auto thread_id = thread_id_storage().load(std::memory_order_relaxed);
+        return thread_id != 0 ? thread_id : Util::OS::thread_id();
+    }
+
+    /**
+     * @brief Sets the current time.
+     *
+     * @param time New time.
+     */
+    static auto set(TimePoint time) noexcept -> void
+    {
+        time_storage().store(time.time_since_epoch().count(), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Moves the current time forward.
+     *
+     * @param duration Time to add.
+     */
+    static auto advance(std::chrono::nanoseconds duration) noexcept -> void
+    {
+        time_storage().fetch_add(duration.count(), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Sets the thread ID reported for all threads.
+     *
+     * @param thread_id Thread ID, zero to report the actual one.
+     */
+    static auto set_thread_id(std::size_t thread_id) noexcept -> void
+    {
+        thread_id_storage().store(thread_id, std::memory_order_relaxed);
+    }
+
+private:
+    static auto time_storage() noexcept -> std::atomic<std::int64_t>&
+    {
+        static std::atomic<std::int64_t> time = 0;
+        return time;
+    }
+
+    static auto thread_id_storage() noexcept -> std::atomic<std::size_t>&
+    {
+        static std::atomic<std::size_t> thread_id = 0;
+        return thread_id;
+    }
+};
+
+/**
+ * @brief Clock policy reading the CPU cycle counter.
+ *
+ * Reads the time stamp counter (see Util::OS::cycle_counter()) and converts it to the wall
+ * clock with a linear mapping calibrated against the real-time clock: the frequency is
+ * measured over the first 10 ms since the first use, and each calibrate() call refines
+ * the frequency over the interval since the previous calibration and corrects the drift.
+ * Until the first measurement the time is read from RealtimeClock, so that logging
+ * never waits for it, and init() measures it eagerly, e.g. at the application start.
+ * The record timestamps thus have nanosecond resolution, unlike the coarse clock
+ * of RealtimeClock, for the price of a counter read and a multiplication.
+ *
+ * Recalibration never steps the time: the new mapping starts where the previous one
+ * ends, and the drift is slewed away by running the clock at most 500 ppm faster or
+ * slower until the next calibration, like adjtime() does. Only a difference beyond
+ * 128 ms, e.g. after the system clock was set, steps the mapping to the real-time clock.
+ *
+ * The mapping is published with a sequence lock, so the readers take no locks
+ * and write no shared memory. The local time zone offset is also taken at calibration,
+ * so the daylight saving time changes apply after the next calibration.
+ *
+ * Without recalibration the timestamps drift away from the real-time clock
+ * (e.g. as NTP adjusts it), so a long-running application should keep a Calibrator,
+ * which recalibrates the clock periodically on a background thread. Requires the counter
+ * to tick at a constant rate synchronized across the cores (`constant_tsc` and
+ * `nonstop_tsc` CPU flags on x86).
+ *
+ * Usage example:
+ * ```cpp
+ * Log::TscClock::Calibrator calibrator; // Calls TscClock::init()
+ * Log::Logger<std::string_view, char, Log::DefaultThreadingPolicy, Log::DefaultBufferSize,
+ *             std::allocator<char>, Log::TscClock> log("main");
+ * log.add_sink<Log::OStreamSink>(std::cout, "{time:%T}.{nsec} {message}");
+ * ```
+ */
+class TscClock final {
+public:
+    /** @brief Default interval of the background recalibration. */
+    static constexpr std::chrono::milliseconds DefaultInterval{1000};
+
+    /**
+     * @brief Recalibrates the clock periodically on a background thread.
+     */
+    class Calibrator final {
+    public:
+        /**
+         * @brief Constructs a new Calibrator object and starts the thread.
+         *
+         * @param interval Interval between the calibrations.
+         */
+        explicit Calibrator(std::chrono::milliseconds interval = DefaultInterval)
+            : m_interval(interval)
+        {
+            TscClock::init();
+            m_thread = std::thread([this] { run(); });
+        }
+
+        Calibrator(Calibrator const&) = delete;
+        Calibrator(Calibrator&&) = delete;
+        auto operator=(Calibrator const&) -> Calibrator& = delete;
+        auto operator=(Calibrator&&) -> Calibrator& = delete;
+
+        /** @brief Stops the thread and destroys the Calibrator object. */
+        ~Calibrator()
+        {
+            {
+                const std::lock_guard lock(m_mutex);
+                m_stop = true;
+            }
+            m_wakeup.notify_one();
+            m_thread.join();
+        }
+
+    private:
+        /** @brief Calibration thread function. */
+        auto run() -> void
+        {
+            std::unique_lock lock(m_mutex);
+            while (!m_wakeup.wait_for(lock, m_interval, [this] { return m_stop; })) {
+                lock.unlock();
+                calibrate();
+                lock.lock();
+            }
+        }
+
+        std::chrono::milliseconds m_interval;
+        bool m_stop = false;
+        std::mutex m_mutex;
+        std::condition_variable m_wakeup;
+        std::thread m_thread;
+    };
+
+    /**
+     * @brief Gets the current time.
+     *
+     * @return Local time and nanoseconds part.
+     */
+    [[nodiscard]] static auto now() -> RecordTime
+    {
+        return to_time(Util::OS::cycle_counter());
+    }
+
+    /**
+     * @brief Gets the current thread ID.
+     *
+     * @return Thread ID.
+     */
+    [[nodiscard]] static auto thread_id() noexcept -> std::size_t
+    {
+        return Util::OS::thread_id();
+    }
+
+    /**
+     * @brief Converts the cycle counter value to the local time.
+     *
+     * Allows to store the raw counter value on the hot path and to convert it later,
+     * e.g. on a background thread.
+     *
+     * @param ticks Counter value (see Util::OS::cycle_counter()).
+     * @return Local time and nanoseconds part.
+     */
+    [[nodiscard]] static auto to_time(std::uint64_t ticks) -> RecordTime
+    {
+        auto& state = TscClock::state();
+        if (!state.ready.load(std::memory_order_acquire)) [[unlikely]] {
+            // Measure the frequency once the first interval is over, but never wait for it
+            if (const std::unique_lock lock(state.mutex, std::try_to_lock); lock.owns_lock()) {
+                state.calibrate();
+            }
+            if (!state.ready.load(std::memory_order_acquire)) {
+                return RealtimeClock::now();
+            }
+        }
+
+        std::uint64_t sequence = 0;
+        std::uint64_t base_ticks = 0;
+        std::int64_t base_ns = 0;
+        double ns_per_tick = 0;
+        std::int64_t offset = 0;
+        do {
+            sequence = state.sequence.load(std::memory_order_acquire);
+            base_ticks = state.base_ticks.load(std::memory_order_relaxed);
+            base_ns = state.base_ns.load(std::memory_order_relaxed);
+            ns_per_tick = state.ns_per_tick.load(std::memory_order_relaxed);
+            offset = state.offset.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+        } while ((sequence & 1U) != 0
+                 || sequence != state.sequence.load(std::memory_order_relaxed));
+
+        // The counter may be read before the calibration on another core
+        const auto delta = static_cast<double>(static_cast<std::int64_t>(ticks - base_ticks));
+        const std::chrono::nanoseconds time{
+            base_ns + static_cast<std::int64_t>(delta * ns_per_tick) + offset};
+        const auto seconds = std::chrono::floor<std::chrono::seconds>(time);
+        return {
+            std::chrono::sys_seconds(seconds),
+            static_cast<std::size_t>((time - seconds).count())};
+    }
+
+    /**
+     * @brief Measures the counter frequency, if not done yet.
+     *
+     * Waits until the first measurement interval of about 10 ms since the first use
+     * of the clock is over. Called by the Calibrator constructor.
+     */
+    static auto init() -> void
+    {
+        auto& state = TscClock::state();
+        const std::lock_guard lock(state.mutex);
+        state.init();
+    }
+
+    /**
+     * @brief Maps the cycle counter to the real-time clock anew.
+     *
+     * Also refines the counter frequency, if the previous calibration
+     * was long enough ago, and takes the local time zone offset.
+     */
+    static auto calibrate() -> void
+    {
+        auto& state = TscClock::state();
+        const std::lock_guard lock(state.mutex);
+        state.calibrate();
+    }
+
+private:
+    /**
+     * @brief Mapping of the cycle counter to the real-time clock.
+     */
+    struct State {
+        /** @brief Minimal interval between the samples to measure the frequency. */
+        static constexpr std::chrono::milliseconds MinInterval{10};
+        /** @brief Largest difference from the real-time clock slewed instead of stepped. */
+        static constexpr std::chrono::milliseconds MaxSlewError{128};
+        /** @brief Largest relative period adjustment while slewing. */
+        static constexpr double MaxSlewRate = 500e-6;
+
+        std::atomic<std::uint64_t> sequence = 0; ///< Sequence lock, odd while updating.
+        std::atomic<std::uint64_t> base_ticks = 0; ///< Counter value at the calibration.
+        std::atomic<std::int64_t> base_ns = 0; ///< Real time at the calibration.
+        std::atomic<double> ns_per_tick = 1.0; ///< Counter period in nanoseconds.
+        std::atomic<std::int64_t> offset = 0; ///< Local time zone offset in nanoseconds.
+        std::atomic<bool> ready = false; ///< Mapping has been published.
+        std::mutex mutex; ///< Serializes the calibrations.
+        std::uint64_t sample_ticks = 0; ///< Counter value of the last sample.
+        std::int64_t sample_ns = 0; ///< Real time of the last sample.
+        double measured_period = 1.0; ///< Measured counter period in nanoseconds.
+        bool measured = false; ///< Counter period has been measured.
+        std::int64_t calibration_ns = 0; ///< Real time of the last calibration, zero if none.
+
+        /** @brief Constructs a new State object and starts measuring the frequency. */
+        State()
+        {
+            std::tie(sample_ticks, sample_ns) = sample();
+        }
+
+        State(State const&) = delete;
+        State(State&&) = delete;
+        auto operator=(State const&) -> State& = delete;
+        auto operator=(State&&) -> State& = delete;
+        ~State() = default;
+
+        /**
+         * @brief Reads the cycle counter and the real-time clock at the same moment.
+         *
+         * Takes the closest of a few attempts, as the reads may be interrupted.
+         *
+         * @return Counter value and real time in nanoseconds since the Unix epoch.
+         */
+        static auto sample() -> std::pair<std::uint64_t, std::int64_t>
+        {
+            constexpr int Attempts = 5;
+            std::pair<std::uint64_t, std::int64_t> result;
+            auto best = std::numeric_limits<std::uint64_t>::max();
+            for (int i = 0; i < Attempts; ++i) {
+                const auto before = Util::OS::cycle_counter();
+                const auto time = std::chrono::system_clock::now();
+                const auto after = Util::OS::cycle_counter();
+                if (after - before < best) {
+                    best = after - before;
+                    result = {
+                        before + (after - before) / 2,
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            time.time_since_epoch())
+                            .count()};
+                }
+            }
+            return result;
+        }
+
+        /** @brief Waits for the first measurement interval and publishes the mapping. */
+        auto init() -> void
+        {
+            while (!measured) {
+                const std::chrono::nanoseconds elapsed{sample().second - sample_ns};
+                std::this_thread::sleep_for(
+                    std::clamp<std::chrono::nanoseconds>(MinInterval - elapsed, {}, MinInterval));
+                calibrate();
+            }
+        }
+
+        /**
+         * @brief Takes a new sample and publishes the mapping.
+         *
+         * Publishes nothing until the frequency has been measured.
+         */
+        auto calibrate() -> void
+        {
+            const auto [ticks, time] = sample();
+            if (ticks > sample_ticks
+                && std::chrono::nanoseconds(time - sample_ns) >= MinInterval) {
+                measured_period = static_cast<double>(time - sample_ns)
+                    / static_cast<double>(ticks - sample_ticks);
+                sample_ticks = ticks;
+                sample_ns = time;
+                measured = true;
+            } else if (!measured && time < sample_ns) {
+                // The real-time clock has been set back, start the measurement anew
+                sample_ticks = ticks;
+                sample_ns = time;
+            }
+            if (!measured) {
+                return;
+            }
+
+            auto start = time;
+            auto period = measured_period;
+            if (calibration_ns != 0) {
+                // Continue the current mapping, so that the time does not jump
+                const auto delta = static_cast<double>(static_cast<std::int64_t>(
+                    ticks - base_ticks.load(std::memory_order_relaxed)));
+                const auto current_period = ns_per_tick.load(std::memory_order_relaxed);
+                const auto mapped = base_ns.load(std::memory_order_relaxed)
+                    + static_cast<std::int64_t>(delta * current_period);
+                const auto error = time - mapped;
+                if (std::chrono::abs(std::chrono::nanoseconds(error)) < MaxSlewError) {
+                    // Catch up with the real-time clock by the next calibration
+                    const auto interval = std::max<std::int64_t>(
+                        time - calibration_ns,
+                        std::chrono::nanoseconds(MinInterval).count());
+                    const auto rate = std::clamp(
+                        static_cast<double>(error) / static_cast<double>(interval),
+                        -MaxSlewRate,
+                        MaxSlewRate);
+                    start = mapped;
+                    period = measured_period * (1.0 + rate);
+                }
+            }
+            calibration_ns = time;
+
+            const auto seconds = static_cast<std::time_t>(
+                std::chrono::floor<std::chrono::seconds>(std::chrono::nanoseconds(time))
+                    .count());
+            const auto local = Util::OS::to_local(seconds).time_since_epoch();
+            const std::chrono::nanoseconds zone = local - std::chrono::seconds(seconds);
+
+            sequence.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            base_ticks.store(ticks, std::memory_order_relaxed);
+            base_ns.store(start, std::memory_order_relaxed);
+            ns_per_tick.store(period, std::memory_order_relaxed);
+            offset.store(zone.count(), std::memory_order_relaxed);
+            sequence.fetch_add(1, std::memory_order_release);
+            ready.store(true, std::memory_order_release);
+        }
+    };
+
+    /**
+     * @brief Gets the clock mapping, starting the frequency measurement on the first call.
+     *
+     * @return State reference.
+     */
+    static auto state() -> State&
+    {
+        static State state;
+        return state;
+    }
+};
+
+} // namespace SlimLog
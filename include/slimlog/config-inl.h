@@ -0,0 +1,328 @@
+/**
+ * @file config-inl.h
+ * @brief Contains definition of Config and ConfigWatcher classes.
+ */
+
+#pragma once
+
+// IWYU pragma: private, include "slimlog/config.h"
+
+#include "slimlog/config.h" // IWYU pragma: associated
+#include "slimlog/pattern.h"
+#include "slimlog/util/unicode.h"
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <optional>
+#include <stdexcept>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace SlimLog {
+
+/** @cond */
+namespace Detail {
+inline auto trim(std::string_view value) -> std::string_view
+{
+    constexpr std::string_view Spaces = " \t\r";
+    const auto begin = value.find_first_not_of(Spaces);
+    if (begin == std::string_view::npos) {
+        return {};
+    }
+    return value.substr(begin, value.find_last_not_of(Spaces) - begin + 1);
+}
+} // namespace Detail
+/** @endcond */
+
+template<typename Logger>
+Config<Logger>::Config(Logger& root)
+    : m_root(root)
+    , m_set_levels([&root](const CategoryFilter<CharType>& filter) { root.set_levels(filter); })
+{
+}
+
+template<typename Logger>
+Config<Logger>::Config(Registry<Logger>& registry)
+    : m_root(registry.root())
+    , m_set_levels([&registry](const CategoryFilter<CharType>& filter) {
+        registry.set_levels(filter);
+    })
+{
+}
+
+template<typename Logger>
+auto Config<Logger>::apply(std::string_view config) -> void
+{
+    struct SinkSettings {
+        SinkEntry* entry = nullptr;
+        std::optional<std::basic_string<CharType>> pattern;
+        std::optional<Level> level;
+        std::optional<bool> enabled;
+    };
+
+    const std::lock_guard lock(m_mutex);
+    std::optional<std::basic_string<CharType>> rules;
+    std::map<std::string_view, SinkSettings, std::less<>> sinks;
+
+    // Parse and validate everything before changing anything
+    for (std::size_t line_number = 1; !config.empty(); ++line_number) {
+        const auto eol = config.find('\n');
+        const auto line = Detail::trim(config.substr(0, eol));
+        config = eol == std::string_view::npos ? std::string_view{} : config.substr(eol + 1);
+        if (line.empty() || line.front() == '#') {
+            continue;
+        }
+
+        const auto error = [line_number](const char* message) {
+            return std::invalid_argument(
+                "config line " + std::to_string(line_number) + ": " + message);
+        };
+
+        const auto equal = line.find('=');
+        if (equal == std::string_view::npos) {
+            throw error("expected 'key = value'");
+        }
+        const auto key = Detail::trim(line.substr(0, equal));
+        const auto value = Detail::trim(line.substr(equal + 1));
+
+        if (key == "levels") {
+            rules = convert(value);
+            // Throws if the rules are malformed
+            const CategoryFilter<CharType> filter(*rules);
+            continue;
+        }
+
+        constexpr std::string_view SinkPrefix = "sink.";
+        const auto option_pos = key.rfind('.');
+        if (!key.starts_with(SinkPrefix) || option_pos < SinkPrefix.size()) {
+            throw error("unknown key");
+        }
+        const auto name = key.substr(SinkPrefix.size(), option_pos - SinkPrefix.size());
+        const auto option = key.substr(option_pos + 1);
+        const auto itr = m_sinks.find(name);
+        if (itr == m_sinks.end()) {
+            throw error("unknown sink");
+        }
+
+        auto& settings = sinks[name];
+        settings.entry = &itr->second;
+        if (option == "pattern") {
+            if (!settings.entry->set_pattern) {
+                throw error("sink has no pattern");
+            }
+            settings.pattern = convert(value);
+            // Throws if the pattern is malformed
+            const Pattern<CharType> pattern(*settings.pattern);
+        } else if (option == "level") {
+            settings.level = parse_level(value);
+            if (!settings.level) {
+                throw error("unknown level");
+            }
+        } else if (option == "enabled") {
+            if (value == "true" || value == "on" || value == "1") {
+                settings.enabled = true;
+            } else if (value == "false" || value == "off" || value == "0") {
+                settings.enabled = false;
+            } else {
+                throw error("expected boolean value");
+            }
+        } else {
+            throw error("unknown sink option");
+        }
+    }
+
+    if (rules) {
+        m_filter.set_rules(*rules);
+        m_set_levels(m_filter);
+    }
+    for (auto& [name, settings] : sinks) {
+        if (settings.pattern) {
+            settings.entry->set_pattern(*settings.pattern);
+        }
+        if (settings.level) {
+            settings.entry->sink->set_level(*settings.level);
+        }
+        if (settings.enabled) {
+            m_root.set_sink_enabled(settings.entry->sink, *settings.enabled);
+        }
+    }
+}
+
+template<typename Logger>
+auto Config<Logger>::load(const std::string& path) -> void
+{
+#if defined(_WIN32) && defined(__STDC_WANT_SECURE_LIB__)
+    FILE* fp;
+    std::ignore = fopen_s(&fp, path.c_str(), "rb");
+    const std::unique_ptr<FILE, int (*)(FILE*)> file{fp, std::fclose};
+#else
+    const std::unique_ptr<FILE, int (*)(FILE*)> file{std::fopen(path.c_str(), "rb"), std::fclose};
+#endif
+    if (!file) {
+        throw std::system_error({errno, std::system_category()}, "Error opening config file");
+    }
+
+    constexpr std::size_t ChunkSize = 4096;
+    std::string config;
+    std::vector<char> chunk(ChunkSize);
+    while (const auto size = std::fread(chunk.data(), 1, chunk.size(), file.get())) {
+        config.append(chunk.data(), size);
+    }
+    if (std::ferror(file.get()) != 0) {
+        throw std::system_error({errno, std::system_category()}, "Failed reading config file");
+    }
+
+    apply(config);
+}
+
+template<typename Logger>
+auto Config<Logger>::convert(std::string_view value) -> std::basic_string<CharType>
+{
+    if constexpr (std::is_same_v<CharType, char>) {
+        return std::string(value);
+    } else {
+        // Each code unit of the result takes at least one byte of the source
+        const std::string source(value);
+        std::basic_string<CharType> result(source.size() + 1, CharType{});
+        const auto written = Util::Unicode::from_multibyte(
+            result.data(), result.size(), source.c_str(), source.size());
+        result.resize(written - 1); // Trim null terminator
+        return result;
+    }
+}
+
+template<typename Logger>
+ConfigWatcher<Logger>::ConfigWatcher(
+    Config<Logger>& config,
+    std::string path,
+    ErrorHandler on_error,
+    std::chrono::milliseconds interval)
+    : m_config(config)
+    , m_path(std::move(path))
+    , m_on_error(std::move(on_error))
+    , m_interval(interval)
+{
+    std::error_code error;
+    m_modified = std::filesystem::last_write_time(m_path, error);
+
+#ifdef __linux__
+    if (::pipe2(m_wakeup.data(), O_CLOEXEC | O_NONBLOCK) != 0) {
+        throw std::system_error({errno, std::system_category()}, "Failed creating pipe");
+    }
+    // Watch the directory, as editors often replace the file instead of writing it
+    m_inotify = ::inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+    if (m_inotify >= 0) {
+        auto directory = std::filesystem::path(m_path).parent_path();
+        if (directory.empty()) {
+            directory = ".";
+        }
+        if (::inotify_add_watch(
+                m_inotify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE)
+            < 0) {
+            ::close(m_inotify);
+            m_inotify = -1;
+        }
+    }
+#endif
+
+    m_thread = std::thread([this] { run(); });
+}
+
+template<typename Logger>
+ConfigWatcher<Logger>::~ConfigWatcher()
+{
+#ifdef __linux__
+    m_stop.store(true, std::memory_order_relaxed);
+    request_reload();
+    m_thread.join();
+    if (m_inotify >= 0) {
+        ::close(m_inotify);
+    }
+    ::close(m_wakeup[0]);
+    ::close(m_wakeup[1]);
+#else
+    {
+        const std::lock_guard lock(m_mutex);
+        m_stop.store(true, std::memory_order_relaxed);
+    }
+    m_wakeup.notify_one();
+    m_thread.join();
+#endif
+}
+
+template<typename Logger>
+auto ConfigWatcher<Logger>::request_reload() noexcept -> void
+{
+    m_reload.store(true, std::memory_order_release);
+#ifdef __linux__
+    const char byte = 0;
+    std::ignore = ::write(m_wakeup[1], &byte, 1);
+#endif
+}
+
+template<typename Logger>
+auto ConfigWatcher<Logger>::run() -> void
+{
+    while (!m_stop.load(std::memory_order_relaxed)) {
+        if (wait()) {
+            reload();
+        }
+    }
+}
+
+template<typename Logger>
+auto ConfigWatcher<Logger>::wait() -> bool
+{
+#ifdef __linux__
+    std::array<pollfd, 2> fds{{{m_wakeup[0], POLLIN, 0}, {m_inotify, POLLIN, 0}}};
+    ::poll(fds.data(), m_inotify >= 0 ? 2 : 1, static_cast<int>(m_interval.count()));
+
+    std::array<char, 4096> buffer; // NOLINT(*-member-init)
+    while (::read(m_wakeup[0], buffer.data(), buffer.size()) > 0) { }
+    if (m_inotify >= 0) {
+        while (::read(m_inotify, buffer.data(), buffer.size()) > 0) { }
+    }
+#else
+    std::unique_lock lock(m_mutex);
+    m_wakeup.wait_for(lock, m_interval, [this] {
+        return m_stop.load(std::memory_order_relaxed);
+    });
+    lock.unlock();
+#endif
+    if (m_stop.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    // Any directory event only triggers the modification time check
+    std::error_code error;
+    const auto modified = std::filesystem::last_write_time(m_path, error);
+    const bool changed = !error && modified != m_modified;
+    if (!error) {
+        m_modified = modified;
+    }
+    return m_reload.exchange(false, std::memory_order_acquire) || changed;
+}
+
+template<typename Logger>
+auto ConfigWatcher<Logger>::reload() -> void
+{
+    try {
+        m_config.load(m_path);
+    } catch (...) {
+        if (m_on_error) {
+            m_on_error(std::current_exception());
+        }
+    }
+}
+
+} // namespace SlimLog
@@ -0,0 +1,256 @@
+/**
+ * @file config.h
+ * @brief Contains declaration of Config and ConfigWatcher classes.
+ */
+
+#pragma once
+
+#include "slimlog/category_filter.h"
+#include "slimlog/level.h"
+#include "slimlog/registry.h"
+#include "slimlog/sink.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+#ifndef __linux__
+#include <condition_variable>
+#endif
+
+namespace SlimLog {
+
+/**
+ * @brief Runtime logging configuration.
+ *
+ * Applies a text configuration to a logger hierarchy. The configuration consists
+ * of `key = value` lines, empty lines and lines starting with `#` are ignored:
+ *
+ * ```
+ * # Category levels (see CategoryFilter)
+ * levels = info, net.http.client = debug, db = warning
+ * # Settings of the sinks registered with add_sink()
+ * sink.file.pattern = {time}.{msec} [{level}] {category}: {message}
+ * sink.file.level = debug
+ * sink.console.enabled = false
+ * ```
+ *
+ * The whole configuration is validated before anything is applied, so a malformed
+ * configuration leaves the current settings intact. New patterns and category rules
+ * are built off to the side and published with one atomic pointer swap each, so they
+ * do not stop the logging threads.
+ *
+ * A valid configuration is not applied atomically as a whole, though: logger levels
+ * are set one logger at a time and each sink setting takes effect on its own, so
+ * messages emitted meanwhile may see a mix of the old and new settings. Enabling or
+ * disabling a sink takes the write lock of the logger hierarchy
+ * (see Logger::set_sink_enabled()), which briefly blocks the logging threads.
+ *
+ * Usage example:
+ * ```cpp
+ * Log::Logger<std::string_view> root("app");
+ * auto file = std::make_shared<Log::FileSink<std::string_view>>("app.log");
+ * root.add_sink(file);
+ *
+ * Log::Config config(root);
+ * config.add_sink("file", file);
+ * config.load("logging.conf");
+ * Log::ConfigWatcher watcher(config, "logging.conf");
+ * ```
+ *
+ * @tparam Logger Logger type.
+ */
+template<typename Logger>
+class Config {
+public:
+    /** @brief Character type for the categories and patterns. */
+    using CharType = typename Logger::CharType;
+    /** @brief Base sink type. */
+    using SinkType = typename Logger::SinkType;
+
+    /**
+     * @brief Constructs a new Config object.
+     *
+     * @param root Root of the logger hierarchy to configure.
+     */
+    explicit Config(Logger& root);
+
+    /**
+     * @brief Constructs a new Config object for the logger registry.
+     *
+     * Category levels are applied through Registry::set_levels(), so the loggers
+     * created after the configuration change get their levels from it as well.
+     *
+     * @param registry Registry of the loggers to configure.
+     */
+    explicit Config(Registry<Logger>& registry);
+
+    /**
+     * @brief Registers the sink to be configured by name.
+     *
+     * The sink has to be added to the root logger to be enabled or disabled.
+     *
+     * @tparam T Sink type.
+     * @param name Sink name used in the configuration.
+     * @param sink Sink to configure.
+     */
+    template<typename T>
+    auto add_sink(std::string name, const std::shared_ptr<T>& sink) -> void
+    {
+        SinkEntry entry{sink, {}};
+        if constexpr (IsFormattableSink<T>) {
+            entry.set_pattern = [sink](std::basic_string_view<CharType> pattern) {
+                sink->set_pattern(pattern);
+            };
+        }
+        const std::lock_guard lock(m_mutex);
+        m_sinks.insert_or_assign(std::move(name), std::move(entry));
+    }
+
+    /**
+     * @brief Applies the configuration text.
+     *
+     * @param config Configuration text.
+     * @throws std::invalid_argument if the configuration is malformed.
+     * @throws FormatError if a sink pattern is malformed.
+     */
+    auto apply(std::string_view config) -> void;
+
+    /**
+     * @brief Loads and applies the configuration file.
+     *
+     * @param path Path to the configuration file.
+     * @throws std::system_error if the file cannot be read.
+     * @throws std::invalid_argument if the configuration is malformed.
+     * @throws FormatError if a sink pattern is malformed.
+     */
+    auto load(const std::string& path) -> void;
+
+private:
+    /**
+     * @brief Configurable sink.
+     */
+    struct SinkEntry {
+        std::shared_ptr<SinkType> sink; ///< Sink.
+        std::function<void(std::basic_string_view<CharType>)> set_pattern; ///< Pattern setter.
+    };
+
+    /**
+     * @brief Converts the multibyte configuration string to the logger character type.
+     *
+     * @param value Multibyte string.
+     * @return Converted string.
+     */
+    static auto convert(std::string_view value) -> std::basic_string<CharType>;
+
+    Logger& m_root;
+    std::function<void(const CategoryFilter<CharType>&)> m_set_levels;
+    CategoryFilter<CharType> m_filter;
+    std::map<std::string, SinkEntry, std::less<>> m_sinks;
+    std::mutex m_mutex;
+};
+
+/**
+ * @brief Configuration file watcher.
+ *
+ * Reloads the configuration in a background thread when the file changes. On Linux
+ * the file is watched with inotify, on other platforms its modification time is
+ * polled. A reload can also be requested explicitly, e.g. from a `SIGHUP` handler.
+ * Errors of the reload keep the previous configuration and are passed to the error
+ * handler, if any.
+ *
+ * Usage example:
+ * ```cpp
+ * static std::unique_ptr<Log::ConfigWatcher<Log::Logger<std::string_view>>> watcher;
+ * watcher = std::make_unique<Log::ConfigWatcher<Log::Logger<std::string_view>>>(
+ *     config, "logging.conf");
+ * std::signal(SIGHUP, [](int) { watcher->request_reload(); });
+ * ```
+ *
+ * @tparam Logger Logger type.
+ */
+template<typename Logger>
+class ConfigWatcher {
+public:
+    /** @brief Error handler type. */
+    using ErrorHandler = std::function<void(std::exception_ptr)>;
+
+    /** @brief Default interval of the modification time checks. */
+    static constexpr std::chrono::milliseconds DefaultInterval{1000};
+
+    /**
+     * @brief Constructs a new ConfigWatcher object and starts watching.
+     *
+     * @param config Configuration to reload.
+     * @param path Path to the configuration file.
+     * @param on_error Handler of the reload errors.
+     * @param interval Interval of the modification time checks.
+     * @throws std::system_error if the watcher cannot be started.
+     */
+    ConfigWatcher(
+        Config<Logger>& config,
+        std::string path,
+        ErrorHandler on_error = {},
+        std::chrono::milliseconds interval = DefaultInterval);
+
+    ConfigWatcher(ConfigWatcher const&) = delete;
+    ConfigWatcher(ConfigWatcher&&) = delete;
+    auto operator=(ConfigWatcher const&) -> ConfigWatcher& = delete;
+    auto operator=(ConfigWatcher&&) -> ConfigWatcher& = delete;
+
+    /** @brief Stops watching and destroys the ConfigWatcher object. */
+    ~ConfigWatcher();
+
+    /**
+     * @brief Requests the configuration reload.
+     *
+     * Async-signal-safe, so it can be called from a signal handler.
+     */
+    auto request_reload() noexcept -> void;
+
+private:
+    /** @brief Watcher thread function. */
+    auto run() -> void;
+
+    /**
+     * @brief Waits for a file change, a reload request or a stop request.
+     *
+     * @return \b true if the configuration has to be reloaded.
+     */
+    auto wait() -> bool;
+
+    /** @brief Reloads the configuration. */
+    auto reload() -> void;
+
+    Config<Logger>& m_config;
+    std::string m_path;
+    ErrorHandler m_on_error;
+    std::chrono::milliseconds m_interval;
+    std::filesystem::file_time_type m_modified;
+    std::atomic<bool> m_reload = false;
+    std::atomic<bool> m_stop = false;
+#ifdef __linux__
+    int m_inotify = -1;
+    std::array<int, 2> m_wakeup = {-1, -1};
+#else
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+#endif
+    std::thread m_thread;
+};
+
+} // namespace SlimLog
+
+#ifdef SLIMLOG_HEADER_ONLY
+#include "slimlog/config-inl.h" // IWYU pragma: keep
+#endif
@@ -16,6 +16,8 @@
 #include <fmt/core.h>
 #endif
 #include <chrono>
+#include <ctime>
+#include <type_traits>
 #else
 #include <array>
 #endif
@@ -80,7 +82,17 @@ void CachedFormatter<T, Char>::format(Out& out, T value) const
             fmt::appender,
             std::back_insert_iterator<decltype(m_buffer)>>;
         fmt::basic_format_context<Appender, Char> fmt_context(Appender(m_buffer), {});
+#if FMT_VERSION < 100000
+        // Before 10.0 libfmt converts the system clock time to the local time zone,
+        // while the record time has been converted by the logger clock already.
+        if constexpr (std::is_same_v<T, std::chrono::sys_seconds>) {
+            fmt::formatter<std::tm, Char>::format(fmt::gmtime(*m_value), fmt_context);
+        } else {
+            Formatter<T, Char>::format(*m_value, fmt_context);
+        }
+#else
         Formatter<T, Char>::format(*m_value, fmt_context);
+#endif
 #else
         // For std::format there is no way to build a custom format context,
         // so we have to use dummy format string (empty string will be omitted),
@@ -59,6 +59,23 @@ template<typename Char>
 using FormatParseContext = std::basic_format_parse_context<Char>;
 #endif
 
+#if defined(SLIMLOG_FMTLIB) and FMT_VERSION >= 110000
+/** @brief Type-erased format arguments. */
+template<typename Char>
+using FormatArgs = fmt::basic_format_args<fmt::buffered_context<Char>>;
+#elif defined(SLIMLOG_FMTLIB)
+/** @brief Type-erased format arguments. */
+template<typename Char>
+using FormatArgs = fmt::basic_format_args<fmt::buffer_context<Char>>;
+#else
+/** @brief Type-erased format arguments. */
+template<typename Char>
+using FormatArgs = std::conditional_t<
+    std::is_same_v<Char, wchar_t>,
+    std::wformat_args,
+    std::format_args>;
+#endif
+
 /**
  * @brief Wrapper class consisting of a format string and location.
  *
@@ -110,6 +127,21 @@ public:
         return m_fmt;
     }
 
+    /**
+     * @brief Gets the format string without the argument types.
+     *
+     * @return The format string view.
+     */
+    [[nodiscard]] constexpr auto view() const -> std::basic_string_view<Char>
+    {
+#ifdef SLIMLOG_FMTLIB
+        const auto view = static_cast<fmt::basic_string_view<Char>>(m_fmt);
+        return {view.data(), view.size()};
+#else
+        return m_fmt.get();
+#endif
+    }
+
     /**
      * @brief Gets the source location.
      *
@@ -235,13 +267,16 @@ public:
     /**
      * @brief Returns an object that stores an array of formatting arguments.
      *
+     * The storage may refer to the arguments, so it must not outlive them.
+     * Convertible to FormatArgs.
+     *
      * @tparam Char Character type of the format string.
      * @tparam Args Format argument types.
      * @param args Format arguments.
      * @return Format argument storage.
      */
     template<typename... Args>
-    static constexpr auto make_format_args(Args... args) -> auto
+    static constexpr auto make_format_args(const Args&... args) -> auto
     {
 #if defined(SLIMLOG_FMTLIB) and FMT_VERSION >= 110000
         return fmt::make_format_args<fmt::buffered_context<Char>>(args...);
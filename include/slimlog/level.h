@@ -5,8 +5,13 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <cstdint>
+#include <optional>
+#include <string_view>
+#include <utility>
 
 namespace SlimLog {
 
@@ -27,6 +32,41 @@ enum class Level : std::uint8_t {
     Trace ///< Trace messages for method entry and exit.
 };
 
+/**
+ * @brief Parses the logging level name.
+ *
+ * Accepts `fatal`, `error`, `warning` (or `warn`), `info`, `debug` and `trace`
+ * in any letter case.
+ *
+ * @tparam Char Character type of the name.
+ * @param name Level name.
+ * @return Level or std::nullopt if the name is unknown.
+ */
+template<typename Char>
+[[nodiscard]] constexpr auto parse_level(std::basic_string_view<Char> name) noexcept
+    -> std::optional<Level>
+{
+    constexpr std::array<std::pair<std::string_view, Level>, 7> Names{{
+        {"fatal", Level::Fatal},
+        {"error", Level::Error},
+        {"warning", Level::Warning},
+        {"warn", Level::Warning},
+        {"info", Level::Info},
+        {"debug", Level::Debug},
+        {"trace", Level::Trace},
+    }};
+
+    for (const auto& [text, level] : Names) {
+        if (std::equal(
+                text.begin(), text.end(), name.begin(), name.end(), [](char lower, Char chr) {
+                    return chr == Char(lower) || chr == Char(lower - 'a' + 'A');
+                })) {
+            return level;
+        }
+    }
+    return std::nullopt;
+}
+
 /**
  * @brief Basic log level driver class.
  *
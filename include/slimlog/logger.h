@@ -5,20 +5,42 @@
 
 #pragma once
 
+#include "slimlog/backtrace.h"
+#include "slimlog/callsite.h"
+#include "slimlog/category_filter.h"
+#include "slimlog/clock.h"
 #include "slimlog/format.h"
 #include "slimlog/level.h"
 #include "slimlog/location.h"
+#include "slimlog/metrics.h"
 #include "slimlog/policy.h"
+#include "slimlog/sampler.h"
 #include "slimlog/sink.h"
 #include "slimlog/util/types.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <type_traits>
 #include <utility>
 
+/**
+ * @brief Marks the function as rarely called and keeps it out of line.
+ *
+ * Moves the function body away from the hot code, so that the callers
+ * only keep the call instruction.
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define SLIMLOG_COLD [[gnu::cold, gnu::noinline]]
+#elif defined(_MSC_VER)
+#define SLIMLOG_COLD __declspec(noinline)
+#else
+#define SLIMLOG_COLD
+#endif
+
 namespace SlimLog {
 
 /**
@@ -31,6 +53,20 @@ static constexpr auto DefaultBufferSize = 256U;
  */
 using DefaultThreadingPolicy = MultiThreadedPolicy;
 
+/**
+ * @brief Tag type selecting the Logger constructors which borrow the category string.
+ *
+ * The logger keeps a view of the category instead of a copy, so the string
+ * must outlive the logger (e.g., a string literal or a category interned by Registry).
+ */
+struct BorrowCategory {
+    /** @brief Constructs a new BorrowCategory tag. */
+    explicit BorrowCategory() = default;
+};
+
+/** @brief Tag value for the Logger constructors which borrow the category string. */
+inline constexpr BorrowCategory BorrowCategoryTag{};
+
 /**
  * @brief Logger front-end class.
  *
@@ -41,13 +77,15 @@ using DefaultThreadingPolicy = MultiThreadedPolicy;
  * @tparam ThreadingPolicy Threading policy for sink operations.
  * @tparam BufferSize Size of the internal pre-allocated buffer.
  * @tparam Allocator Allocator type for the internal buffer.
+ * @tparam Clock Clock policy providing the record time and thread ID (e.g., RealtimeClock).
  */
 template<
     typename String,
     typename Char = Util::Types::UnderlyingCharType<String>,
     typename ThreadingPolicy = DefaultThreadingPolicy,
     std::size_t BufferSize = DefaultBufferSize,
-    typename Allocator = std::allocator<Char>>
+    typename Allocator = std::allocator<Char>,
+    typename Clock = RealtimeClock>
 class Logger {
 public:
     /** @brief String type for log messages. */
@@ -60,6 +98,10 @@ public:
     using SinkType = Sink<String, Char>;
     /** @brief Buffer type used for log message formatting. */
     using FormatBufferType = FormatBuffer<Char, BufferSize, Allocator>;
+    /** @brief Per-thread backtrace type. */
+    using BacktraceType = Backtrace<Char, BufferSize, Allocator>;
+    /** @brief Clock policy for the record time and thread ID. */
+    using ClockType = Clock;
 
     Logger(Logger const&) = delete;
     Logger(Logger&&) = delete;
@@ -74,7 +116,26 @@ public:
      * @param level Logging level.
      */
     explicit Logger(StringViewType category, Level level = Level::Info)
-        : m_category(category) // NOLINT(*-array-to-pointer-decay,*-no-array-decay)
+        : m_category_storage(category) // NOLINT(*-array-to-pointer-decay,*-no-array-decay)
+        , m_category(m_category_storage)
+        , m_level(level)
+        , m_sinks(this)
+    {
+    }
+
+    /**
+     * @brief Constructs a new Logger object borrowing the category string.
+     *
+     * Usage example:
+     * ```cpp
+     * Log::Logger<std::string_view> log(Log::BorrowCategoryTag, "main");
+     * ```
+     *
+     * @param category Logger category name. Must outlive the logger.
+     * @param level Logging level.
+     */
+    Logger(BorrowCategory /*unused*/, StringViewType category, Level level = Level::Info)
+        : m_category(category)
         , m_level(level)
         , m_sinks(this)
     {
@@ -88,7 +149,8 @@ public:
      * @param parent Parent logger to inherit sinks from.
      */
     explicit Logger(StringViewType category, Level level, Logger& parent)
-        : m_category(category)
+        : m_category_storage(category)
+        , m_category(m_category_storage)
         , m_level(level)
         , m_sinks(this, &parent.m_sinks)
     {
@@ -101,6 +163,20 @@ public:
      * @param parent Parent logger to inherit sinks and logging level from.
      */
     explicit Logger(StringViewType category, Logger& parent)
+        : m_category_storage(category)
+        , m_category(m_category_storage)
+        , m_level(parent.level())
+        , m_sinks(this, &parent.m_sinks)
+    {
+    }
+
+    /**
+     * @brief Constructs a new child Logger object borrowing the category string.
+     *
+     * @param category Logger category name. Must outlive the logger.
+     * @param parent Parent logger to inherit sinks and logging level from.
+     */
+    Logger(BorrowCategory /*unused*/, StringViewType category, Logger& parent)
         : m_category(category)
         , m_level(parent.level())
         , m_sinks(this, &parent.m_sinks)
@@ -114,7 +190,7 @@ public:
      */
     [[nodiscard]] auto category() const -> StringViewType
     {
-        return StringViewType{m_category};
+        return m_category;
     }
 
     /**
@@ -223,6 +299,54 @@ public:
         return static_cast<Level>(m_level);
     }
 
+    /**
+     * @brief Sets the logging levels of this logger and its descendants from the category filter.
+     *
+     * The level of each logger is looked up by its category once, so the message-time
+     * check stays a plain level comparison. Call it again after the filter rules change.
+     *
+     * @param filter Category filter.
+     */
+    auto set_levels(const CategoryFilter<Char>& filter) -> void
+    {
+        auto visitor = [&filter](Logger& logger) {
+            logger.set_level(filter.level(logger.category()));
+        };
+        m_sinks.visit(visitor);
+    }
+
+    /**
+     * @brief Sets the backtrace level.
+     *
+     * Messages which do not pass the logging level, but fit the backtrace level, are held back
+     * in a small per-thread ring (see Backtrace) instead of being passed to the sinks.
+     * When the same thread emits an error or a fatal message, the held back messages
+     * of this logger are emitted first. Only formatted and plain string messages are kept.
+     * Level::Fatal (default) disables the backtrace, as no message can be below it.
+     *
+     * Usage example:
+     * ```cpp
+     * Log::Logger log("main", Log::Level::Info);
+     * log.set_backtrace_level(Log::Level::Debug);
+     * ```
+     *
+     * @param level Most verbose level kept in the backtrace.
+     */
+    auto set_backtrace_level(Level level) -> void
+    {
+        m_backtrace_level = level;
+    }
+
+    /**
+     * @brief Gets the backtrace level.
+     *
+     * @return Backtrace level for this logger.
+     */
+    [[nodiscard]] auto backtrace_level() const -> Level
+    {
+        return static_cast<Level>(m_backtrace_level);
+    }
+
     /**
      * @brief Checks if a particular logging level is enabled for the logger.
      *
@@ -235,6 +359,41 @@ public:
         return static_cast<Level>(m_level) >= level;
     }
 
+    /**
+     * @brief Checks if a message of the particular level is emitted or kept in the backtrace.
+     *
+     * The level macros check it before evaluating the message arguments.
+     *
+     * @param level Log level to check.
+     * @return \b true if the specified \p level is enabled or fits the backtrace level.
+     * @return \b false if a message of the specified \p level would be dropped.
+     */
+    [[nodiscard]] auto message_enabled(Level level) const noexcept -> bool
+    {
+        return level_enabled(level) || static_cast<Level>(m_backtrace_level) >= level;
+    }
+
+    /**
+     * @brief Reads the metrics of the messages emitted by this logger without locking.
+     *
+     * Counts the records emitted per level, the records rejected by all sinks,
+     * the formatted bytes and the messages which outgrew the inline buffer.
+     * Messages dropped by the level check in front of the call (see `SLIMLOG_INFO`
+     * and other level macros) do not reach the logger and are not counted.
+     *
+     * Usage example:
+     * ```cpp
+     * const auto metrics = log.metrics();
+     * std::cout << metrics.emitted[static_cast<std::size_t>(Log::Level::Error)] << '\n';
+     * ```
+     *
+     * @return Metrics snapshot, all zeros if `SLIMLOG_METRICS` is not defined.
+     */
+    [[nodiscard]] auto metrics() const noexcept -> LoggerMetrics
+    {
+        return m_sinks.metrics();
+    }
+
     /**
      * @brief Emits a new callback-based log message if it fits the specified logging level.
      *
@@ -253,6 +412,18 @@ public:
     auto message(Level level, T&& callback, Location location = Location::current(), Args&&... args)
         const -> void
     {
+        if constexpr (std::is_convertible_v<T, StringViewType>) {
+            if (backtrace_enabled(level)) [[unlikely]] {
+                // NOLINTNEXTLINE(*-array-to-pointer-decay,*-no-array-decay)
+                BacktraceType::local().push(
+                    m_id, level, location, Clock::now(), StringViewType{callback});
+                return;
+            }
+        }
+        if (level <= Level::Error && level_enabled(level)) [[unlikely]] {
+            replay_backtrace();
+        }
+
         m_sinks.message(
             level, std::forward<T>(callback), category(), location, std::forward<Args>(args)...);
     }
@@ -271,11 +442,19 @@ public:
     void
     message(Level level, Format<CharType, std::type_identity_t<Args>...> fmt, Args&&... args) const
     {
-        auto callback = [&fmt = fmt.fmt()](FormatBufferType& buffer, Args&&... args) {
-            buffer.format(fmt, std::forward<Args>(args)...);
-        };
+        if (backtrace_enabled(level)) [[unlikely]] {
+            BacktraceType::local().template push<Args...>(
+                m_id, level, fmt.loc(), Clock::now(), fmt.fmt(), std::forward<Args>(args)...);
+            return;
+        }
+
+        if (level <= Level::Error && level_enabled(level)) [[unlikely]] {
+            replay_backtrace();
+        }
 
-        this->message(level, std::move(callback), fmt.loc(), std::forward<Args>(args)...);
+        // Only the argument packing is instantiated per call signature
+        const auto store = FormatBufferType::make_format_args(args...);
+        m_sinks.vmessage(level, category(), fmt.loc(), fmt.view(), store);
     }
 
     /**
@@ -308,9 +487,207 @@ public:
         this->message(Level::Info, std::forward<T>(message), location);
     }
 
+    /**
+     * @brief Emits every \p n -th formatted message from the call site.
+     *
+     * Each emitted message but the first is followed by a summary with the number
+     * of suppressed messages. The caller checks message_enabled() first, so that messages
+     * dropped by the logger levels do not advance the sampler.
+     * The sampler has to be unique per call site, see `SLIMLOG_EVERY_N` macro.
+     *
+     * @tparam Args Format argument types. Deduced from arguments.
+     * @param sampler Call site sampling state.
+     * @param n Sampling interval.
+     * @param level Logging level.
+     * @param fmt Format string. See `fmt::format` documentation for details.
+     * @param args Format arguments. Use variadic args for `fmt::format`-based formatting.
+     */
+    template<typename... Args>
+    auto message_every_n(
+        Sampler& sampler,
+        std::uint64_t n,
+        Level level,
+        Format<CharType, std::type_identity_t<Args>...> fmt,
+        Args&&... args) const -> void
+    {
+        if (const auto suppressed = sampler.every_n(n)) [[unlikely]] {
+            message_sampled(*suppressed, level, std::move(fmt), std::forward<Args>(args)...);
+        }
+    }
+
+    /**
+     * @brief Emits the formatted message from the call site only once.
+     *
+     * The caller checks message_enabled() first, so that a message dropped by the logger
+     * levels does not use up the shot.
+     * The sampler has to be unique per call site, see `SLIMLOG_ONCE` macro.
+     *
+     * @tparam Args Format argument types. Deduced from arguments.
+     * @param sampler Call site sampling state.
+     * @param level Logging level.
+     * @param fmt Format string. See `fmt::format` documentation for details.
+     * @param args Format arguments. Use variadic args for `fmt::format`-based formatting.
+     */
+    template<typename... Args>
+    auto message_once(
+        Sampler& sampler,
+        Level level,
+        Format<CharType, std::type_identity_t<Args>...> fmt,
+        Args&&... args) const -> void
+    {
+        if (sampler.once()) [[unlikely]] {
+            this->message(level, std::move(fmt), std::forward<Args>(args)...);
+        }
+    }
+
+    /**
+     * @brief Emits at most \p per_second formatted messages per second from the call site.
+     *
+     * If some messages have been suppressed since the previous emitted one,
+     * the message is followed by a summary with the number of suppressed messages.
+     * The caller checks message_enabled() first, so that messages dropped by the logger
+     * levels neither spend tokens nor count as suppressed.
+     * The sampler has to be unique per call site, see `SLIMLOG_RATE_LIMITED` macro.
+     *
+     * @tparam Args Format argument types. Deduced from arguments.
+     * @param sampler Call site sampling state.
+     * @param per_second Maximum message rate.
+     * @param level Logging level.
+     * @param fmt Format string. See `fmt::format` documentation for details.
+     * @param args Format arguments. Use variadic args for `fmt::format`-based formatting.
+     */
+    template<typename... Args>
+    auto message_rate_limited(
+        Sampler& sampler,
+        double per_second,
+        Level level,
+        Format<CharType, std::type_identity_t<Args>...> fmt,
+        Args&&... args) const -> void
+    {
+        if (const auto suppressed = sampler.rate_limited(per_second)) [[unlikely]] {
+            message_sampled(*suppressed, level, std::move(fmt), std::forward<Args>(args)...);
+        }
+    }
+
+    /**
+     * @brief Emits the formatted message from the dynamically switched call site.
+     *
+     * The message of a switched on call site bypasses the logger levels (sink levels and
+     * filters still apply), otherwise the logger levels decide as usual. Kept out of line,
+     * as the macros check the switch and the level before the call.
+     * The call site has to be unique, see `SLIMLOG_DEBUG` and `SLIMLOG_TRACE` macros.
+     *
+     * @tparam Args Format argument types. Deduced from arguments.
+     * @param site Call site switch.
+     * @param level Logging level.
+     * @param fmt Format string. See `fmt::format` documentation for details.
+     * @param args Format arguments. Use variadic args for `fmt::format`-based formatting.
+     */
+    template<typename... Args>
+    SLIMLOG_COLD auto message_dynamic(
+        CallSite& site,
+        Level level,
+        Format<CharType, std::type_identity_t<Args>...> fmt,
+        Args&&... args) const -> void
+    {
+        if (site.enabled()) [[unlikely]] {
+            FormatBufferType buffer; // NOLINT(misc-const-correctness)
+            buffer.format(fmt.fmt(), std::forward<Args>(args)...);
+            m_sinks.emit(
+                level,
+                category(),
+                fmt.loc(),
+                Clock::now(),
+                StringViewType{buffer.data(), buffer.size()});
+            return;
+        }
+        this->message(level, std::move(fmt), std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Emits the formatted message from the out-of-line cold function.
+     *
+     * Instantiated once per format argument types and kept out of the callers,
+     * so that a call site with a level check in front of it stays small.
+     * See `SLIMLOG_INFO` and other level macros.
+     *
+     * @tparam Args Format argument types. Deduced from arguments.
+     * @param level Logging level.
+     * @param fmt Format string. See `fmt::format` documentation for details.
+     * @param args Format arguments. Use variadic args for `fmt::format`-based formatting.
+     */
+    template<typename... Args>
+    SLIMLOG_COLD auto message_cold(
+        Level level, Format<CharType, std::type_identity_t<Args>...> fmt, Args&&... args) const
+        -> void
+    {
+        this->message(level, std::move(fmt), std::forward<Args>(args)...);
+    }
+
 private:
-    std::basic_string<Char> m_category;
+    /**
+     * @brief Emits the message let through by a sampler, followed by the suppression summary.
+     *
+     * @tparam Args Format argument types. Deduced from arguments.
+     * @param suppressed Number of messages suppressed since the previous emitted one.
+     * @param level Logging level.
+     * @param fmt Format string. See `fmt::format` documentation for details.
+     * @param args Format arguments. Use variadic args for `fmt::format`-based formatting.
+     */
+    template<typename... Args>
+    auto message_sampled(
+        std::uint64_t suppressed,
+        Level level,
+        Format<CharType, std::type_identity_t<Args>...> fmt,
+        Args&&... args) const -> void
+    {
+        const auto location = fmt.loc();
+        this->message(level, std::move(fmt), std::forward<Args>(args)...);
+        if (suppressed > 0) {
+            this->message(
+                level,
+                [suppressed](FormatBufferType& buffer) {
+                    buffer.vformat(
+                        StringViewType{SuppressedFormat<Char>.data()},
+                        FormatBufferType::make_format_args(suppressed));
+                },
+                location);
+        }
+    }
+
+    /**
+     * @brief Checks if a message of the particular level has to be kept in the backtrace.
+     *
+     * @param level Log level to check.
+     * @return \b true if the message does not pass the logging level, but fits the backtrace.
+     */
+    [[nodiscard]] auto backtrace_enabled(Level level) const noexcept -> bool
+    {
+        return !level_enabled(level) && static_cast<Level>(m_backtrace_level) >= level;
+    }
+
+    /**
+     * @brief Emits the messages kept in the backtrace of the calling thread.
+     */
+    auto replay_backtrace() const -> void
+    {
+        auto& backtrace = BacktraceType::local();
+        if (backtrace.empty()) [[likely]] {
+            return;
+        }
+
+        backtrace.replay(
+            m_id,
+            [this](Level level, Location location, RecordTime time, StringViewType message) {
+                m_sinks.emit(level, category(), location, time, message);
+            });
+    }
+
+    std::basic_string<Char> m_category_storage;
+    StringViewType m_category;
     LevelDriver<ThreadingPolicy> m_level;
+    LevelDriver<ThreadingPolicy> m_backtrace_level{Level::Fatal};
+    std::uint64_t m_id = BacktraceType::next_id();
     SinkDriver<Logger, ThreadingPolicy> m_sinks;
 };
 
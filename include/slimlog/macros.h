@@ -0,0 +1,196 @@
+/**
+ * @file macros.h
+ * @brief Contains logging macros which need a per-call-site state.
+ */
+
+#pragma once
+
+#include "slimlog/callsite.h" // IWYU pragma: export
+#include "slimlog/level.h" // IWYU pragma: export
+#include "slimlog/location.h" // IWYU pragma: export
+#include "slimlog/sampler.h" // IWYU pragma: export
+
+/**
+ * @brief Emits every \p n -th formatted message from the call site.
+ *
+ * Like `SLIMLOG_MESSAGE`, checks the logger levels before evaluating the arguments,
+ * and only the messages which pass them are counted. Emitted messages are followed
+ * by a summary with the number of suppressed messages.
+ *
+ * Usage example:
+ * ```cpp
+ * SLIMLOG_EVERY_N(log, Log::Level::Warning, 1000, "Queue is full: {}", size);
+ * ```
+ *
+ * @param logger Logger object.
+ * @param level Logging level.
+ * @param n Sampling interval.
+ * @param ... Format string and arguments.
+ */
+#define SLIMLOG_EVERY_N(logger, level, n, ...)                                                     \
+    do {                                                                                           \
+        const auto& slimlog_logger = (logger);                                                     \
+        const ::SlimLog::Level slimlog_level = (level);                                            \
+        if (slimlog_logger.message_enabled(slimlog_level)) [[unlikely]] {                          \
+            static ::SlimLog::Sampler slimlog_sampler;                                             \
+            slimlog_logger.message_every_n(slimlog_sampler, (n), slimlog_level, __VA_ARGS__);      \
+        }                                                                                          \
+    } while (false)
+
+/**
+ * @brief Emits the formatted message from the call site only once.
+ *
+ * The shot is used up by the first message which passes the logger levels only,
+ * the arguments are not evaluated otherwise.
+ *
+ * Usage example:
+ * ```cpp
+ * SLIMLOG_ONCE(log, Log::Level::Warning, "Deprecated option: {}", name);
+ * ```
+ *
+ * @param logger Logger object.
+ * @param level Logging level.
+ * @param ... Format string and arguments.
+ */
+#define SLIMLOG_ONCE(logger, level, ...)                                                           \
+    do {                                                                                           \
+        const auto& slimlog_logger = (logger);                                                     \
+        const ::SlimLog::Level slimlog_level = (level);                                            \
+        if (slimlog_logger.message_enabled(slimlog_level)) [[unlikely]] {                          \
+            static ::SlimLog::Sampler slimlog_sampler;                                             \
+            slimlog_logger.message_once(slimlog_sampler, slimlog_level, __VA_ARGS__);              \
+        }                                                                                          \
+    } while (false)
+
+/**
+ * @brief Emits at most \p per_second formatted messages per second from the call site.
+ *
+ * Suppressed messages are reported with a summary after the next emitted one.
+ * Messages which do not pass the logger levels are dropped before the rate limiter
+ * and their arguments are not evaluated.
+ *
+ * Usage example:
+ * ```cpp
+ * SLIMLOG_RATE_LIMITED(log, Log::Level::Error, 10, "Connection failed: {}", error);
+ * ```
+ *
+ * @param logger Logger object.
+ * @param level Logging level.
+ * @param per_second Maximum message rate.
+ * @param ... Format string and arguments.
+ */
+#define SLIMLOG_RATE_LIMITED(logger, level, per_second, ...)                                       \
+    do {                                                                                           \
+        const auto& slimlog_logger = (logger);                                                     \
+        const ::SlimLog::Level slimlog_level = (level);                                            \
+        if (slimlog_logger.message_enabled(slimlog_level)) [[unlikely]] {                          \
+            static ::SlimLog::Sampler slimlog_sampler;                                             \
+            slimlog_logger.message_rate_limited(                                                   \
+                slimlog_sampler, (per_second), slimlog_level, __VA_ARGS__);                        \
+        }                                                                                          \
+    } while (false)
+
+/**
+ * @brief Emits the formatted message if the level is enabled for the logger.
+ *
+ * Unlike the Logger methods, checks the logger levels before evaluating the format
+ * arguments, and calls the formatting code out of line (see Logger::message_cold()),
+ * so that the call site shrinks to a few loads, compares and a jump. Messages which
+ * fit the backtrace level pass the check and are kept in the backtrace as usual
+ * (see Logger::message_enabled()).
+ *
+ * Usage example:
+ * ```cpp
+ * SLIMLOG_MESSAGE(log, Log::Level::Info, "Connected to {}", expensive_peer_name());
+ * ```
+ *
+ * @param logger Logger object.
+ * @param level Logging level.
+ * @param ... Format string and arguments.
+ */
+#define SLIMLOG_MESSAGE(logger, level, ...)                                                        \
+    do {                                                                                           \
+        const auto& slimlog_logger = (logger);                                                     \
+        const ::SlimLog::Level slimlog_level = (level);                                            \
+        if (slimlog_logger.message_enabled(slimlog_level)) [[unlikely]] {                          \
+            slimlog_logger.message_cold(slimlog_level, __VA_ARGS__);                               \
+        }                                                                                          \
+    } while (false)
+
+/**
+ * @brief Emits the fatal message if the level is enabled for the logger.
+ *
+ * @param logger Logger object.
+ * @param ... Format string and arguments.
+ */
+#define SLIMLOG_FATAL(logger, ...) SLIMLOG_MESSAGE(logger, ::SlimLog::Level::Fatal, __VA_ARGS__)
+
+/**
+ * @brief Emits the error message if the level is enabled for the logger.
+ *
+ * @param logger Logger object.
+ * @param ... Format string and arguments.
+ */
+#define SLIMLOG_ERROR(logger, ...) SLIMLOG_MESSAGE(logger, ::SlimLog::Level::Error, __VA_ARGS__)
+
+/**
+ * @brief Emits the warning message if the level is enabled for the logger.
+ *
+ * @param logger Logger object.
+ * @param ... Format string and arguments.
+ */
+#define SLIMLOG_WARNING(logger, ...) SLIMLOG_MESSAGE(logger, ::SlimLog::Level::Warning, __VA_ARGS__)
+
+/**
+ * @brief Emits the informational message if the level is enabled for the logger.
+ *
+ * @param logger Logger object.
+ * @param ... Format string and arguments.
+ */
+#define SLIMLOG_INFO(logger, ...) SLIMLOG_MESSAGE(logger, ::SlimLog::Level::Info, __VA_ARGS__)
+
+/**
+ * @brief Emits the formatted message from the dynamically switched call site.
+ *
+ * The call site registers itself on the first execution and can be switched on
+ * at runtime with CallSite::set_enabled(), regardless of the logger levels.
+ * Otherwise the message is emitted if the level is enabled or kept in the backtrace
+ * if it fits the backtrace level (see Logger::message_enabled()).
+ * Like `SLIMLOG_MESSAGE`, evaluates the arguments only if the message is emitted.
+ *
+ * Usage example:
+ * ```cpp
+ * SLIMLOG_DYNAMIC(log, Log::Level::Debug, "Parsed {} tokens", count);
+ * ```
+ *
+ * @param logger Logger object.
+ * @param level Logging level.
+ * @param ... Format string and arguments.
+ */
+#define SLIMLOG_DYNAMIC(logger, level, ...)                                                        \
+    do {                                                                                           \
+        static ::SlimLog::CallSite slimlog_site{::SlimLog::Location::current(                      \
+            ::SlimLog::Detail::extract_file_name(__FILE__), __func__, __LINE__)};                  \
+        const auto& slimlog_logger = (logger);                                                     \
+        const ::SlimLog::Level slimlog_level = (level);                                            \
+        if (slimlog_site.enabled() || slimlog_logger.message_enabled(slimlog_level))               \
+            [[unlikely]] {                                                                         \
+            slimlog_logger.message_dynamic(slimlog_site, slimlog_level, __VA_ARGS__);              \
+        }                                                                                          \
+    } while (false)
+
+/**
+ * @brief Emits the debug message from the dynamically switched call site.
+ *
+ * @param logger Logger object.
+ * @param ... Format string and arguments.
+ */
+#define SLIMLOG_DEBUG(logger, ...) SLIMLOG_DYNAMIC(logger, ::SlimLog::Level::Debug, __VA_ARGS__)
+
+/**
+ * @brief Emits the trace message from the dynamically switched call site.
+ *
+ * @param logger Logger object.
+ * @param ... Format string and arguments.
+ */
+#define SLIMLOG_TRACE(logger, ...) SLIMLOG_DYNAMIC(logger, ::SlimLog::Level::Trace, __VA_ARGS__)
@@ -0,0 +1,266 @@
+/**
+ * @file metrics.h
+ * @brief Contains the self-metrics counters of the loggers and sinks.
+ */
+
+#pragma once
+
+#include "slimlog/level.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+
+namespace SlimLog {
+
+/** @brief Self-metrics are compiled in (see `SLIMLOG_METRICS`). */
+#ifdef SLIMLOG_METRICS
+inline constexpr bool MetricsEnabled = true;
+#else
+inline constexpr bool MetricsEnabled = false;
+#endif
+
+/** @brief Number of the logging levels. */
+inline constexpr std::size_t LevelCount = static_cast<std::size_t>(Level::Trace) + 1;
+
+/**
+ * @brief Snapshot of the logger metrics.
+ *
+ * All values are zero if the metrics are disabled at compile time.
+ */
+struct LoggerMetrics {
+    std::array<std::uint64_t, LevelCount> emitted = {}; ///< Emitted records indexed by Level.
+    std::uint64_t filtered = 0; ///< Records rejected by all sinks before formatting.
+    std::uint64_t bytes_formatted = 0; ///< Bytes of the formatted messages.
+    std::uint64_t buffer_growths = 0; ///< Messages which outgrew the inline buffer.
+
+    /**
+     * @brief Gets the number of the emitted records of all levels.
+     *
+     * @return Number of the emitted records.
+     */
+    [[nodiscard]] auto emitted_total() const noexcept -> std::uint64_t
+    {
+        return std::accumulate(emitted.begin(), emitted.end(), std::uint64_t{0});
+    }
+};
+
+/**
+ * @brief Snapshot of the sink metrics.
+ *
+ * All values are zero if the metrics are disabled at compile time.
+ */
+struct SinkMetrics {
+    std::uint64_t records = 0; ///< Records passed to the sink.
+    std::uint64_t bytes_written = 0; ///< Bytes written to the destination.
+    std::uint64_t buffer_growths = 0; ///< Records which outgrew the inline formatting buffer.
+    std::uint64_t dropped = 0; ///< Records discarded by the sink (throttled, repeated, lost).
+    std::uint64_t flushes = 0; ///< Number of the flushes.
+};
+
+namespace Detail {
+
+/**
+ * @brief Cache line size assumed for padding.
+ *
+ * `std::hardware_destructive_interference_size` is not used,
+ * as its value may differ between the compiler flags and breaks the ABI.
+ */
+inline constexpr std::size_t CacheLineSize = 64;
+
+/**
+ * @brief Relaxed atomic counter occupying a cache line.
+ *
+ * Counters updated from different threads do not share cache lines,
+ * so counting never causes false sharing with each other.
+ */
+struct alignas(CacheLineSize) MetricCounter {
+    std::atomic<std::uint64_t> value = 0; ///< Counter value.
+
+    /**
+     * @brief Increments the counter.
+     *
+     * @param count Increment.
+     */
+    auto add(std::uint64_t count = 1) noexcept -> void
+    {
+        value.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Reads the counter.
+     *
+     * @return Counter value.
+     */
+    [[nodiscard]] auto load() const noexcept -> std::uint64_t
+    {
+        return value.load(std::memory_order_relaxed);
+    }
+};
+
+} // namespace Detail
+
+/**
+ * @brief Counters of the logger.
+ *
+ * Updated with relaxed atomic increments on the emitting threads
+ * and read without locks by snapshot(). The class is empty and all
+ * the methods are no-op if `SLIMLOG_METRICS` is not defined.
+ */
+class LoggerCounters final {
+public:
+    /**
+     * @brief Accounts the emitted record.
+     *
+     * @param level Record level.
+     * @param bytes Size of the formatted message in bytes.
+     * @param grown Message outgrew the inline buffer.
+     */
+    auto emitted(
+        [[maybe_unused]] Level level,
+        [[maybe_unused]] std::size_t bytes,
+        [[maybe_unused]] bool grown) noexcept -> void
+    {
+#ifdef SLIMLOG_METRICS
+        m_emitted[static_cast<std::size_t>(level)].add(); // NOLINT(*-constant-array-index)
+        if (bytes > 0) {
+            m_bytes_formatted.add(bytes);
+        }
+        if (grown) [[unlikely]] {
+            m_buffer_growths.add();
+        }
+#endif
+    }
+
+    /**
+     * @brief Accounts the record rejected by all sinks.
+     */
+    auto filtered() noexcept -> void
+    {
+#ifdef SLIMLOG_METRICS
+        m_filtered.add();
+#endif
+    }
+
+    /**
+     * @brief Reads the counters.
+     *
+     * @return Metrics snapshot.
+     */
+    [[nodiscard]] auto snapshot() const noexcept -> LoggerMetrics
+    {
+        LoggerMetrics result;
+#ifdef SLIMLOG_METRICS
+        for (std::size_t i = 0; i < LevelCount; ++i) {
+            result.emitted[i] = m_emitted[i].load(); // NOLINT(*-constant-array-index)
+        }
+        result.filtered = m_filtered.load();
+        result.bytes_formatted = m_bytes_formatted.load();
+        result.buffer_growths = m_buffer_growths.load();
+#endif
+        return result;
+    }
+
+#ifdef SLIMLOG_METRICS
+private:
+    std::array<Detail::MetricCounter, LevelCount> m_emitted;
+    Detail::MetricCounter m_filtered;
+    Detail::MetricCounter m_bytes_formatted;
+    Detail::MetricCounter m_buffer_growths;
+#endif
+};
+
+/**
+ * @brief Counters of the sink.
+ *
+ * Updated with relaxed atomic increments on the emitting threads
+ * and read without locks by snapshot(). The class is empty and all
+ * the methods are no-op if `SLIMLOG_METRICS` is not defined.
+ */
+class SinkCounters final {
+public:
+    /**
+     * @brief Accounts the record passed to the sink.
+     */
+    auto record() noexcept -> void
+    {
+#ifdef SLIMLOG_METRICS
+        m_records.add();
+#endif
+    }
+
+    /**
+     * @brief Accounts the bytes written to the destination.
+     *
+     * @param bytes Number of bytes.
+     */
+    auto written([[maybe_unused]] std::size_t bytes) noexcept -> void
+    {
+#ifdef SLIMLOG_METRICS
+        m_bytes_written.add(bytes);
+#endif
+    }
+
+    /**
+     * @brief Accounts the record which outgrew the inline formatting buffer.
+     */
+    auto grown() noexcept -> void
+    {
+#ifdef SLIMLOG_METRICS
+        m_buffer_growths.add();
+#endif
+    }
+
+    /**
+     * @brief Accounts the discarded records.
+     *
+     * @param count Number of records.
+     */
+    auto dropped([[maybe_unused]] std::uint64_t count = 1) noexcept -> void
+    {
+#ifdef SLIMLOG_METRICS
+        m_dropped.add(count);
+#endif
+    }
+
+    /**
+     * @brief Accounts the flush.
+     */
+    auto flushed() noexcept -> void
+    {
+#ifdef SLIMLOG_METRICS
+        m_flushes.add();
+#endif
+    }
+
+    /**
+     * @brief Reads the counters.
+     *
+     * @return Metrics snapshot.
+     */
+    [[nodiscard]] auto snapshot() const noexcept -> SinkMetrics
+    {
+        SinkMetrics result;
+#ifdef SLIMLOG_METRICS
+        result.records = m_records.load();
+        result.bytes_written = m_bytes_written.load();
+        result.buffer_growths = m_buffer_growths.load();
+        result.dropped = m_dropped.load();
+        result.flushes = m_flushes.load();
+#endif
+        return result;
+    }
+
+#ifdef SLIMLOG_METRICS
+private:
+    Detail::MetricCounter m_records;
+    Detail::MetricCounter m_bytes_written;
+    Detail::MetricCounter m_buffer_growths;
+    Detail::MetricCounter m_dropped;
+    Detail::MetricCounter m_flushes;
+#endif
+};
+
+} // namespace SlimLog
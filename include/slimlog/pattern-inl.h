@@ -170,6 +170,9 @@ auto Pattern<Char>::set_levels(std::initializer_list<std::pair<Level, StringView
 template<typename Char>
 void Pattern<Char>::compile(StringViewType pattern)
 {
+    if (pattern.data() != m_source.data()) {
+        m_source.assign(pattern);
+    }
     m_placeholders.clear();
     m_pattern.clear();
     m_pattern.reserve(pattern.size());
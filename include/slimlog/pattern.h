@@ -194,6 +194,40 @@ public:
         compile(pattern);
     }
 
+    /**
+     * @brief Copy constructor.
+     *
+     * Placeholders refer to the pattern storage, so the copy compiles the pattern again.
+     *
+     * @param pattern Pattern to copy.
+     */
+    Pattern(Pattern const& pattern)
+        : m_levels(pattern.m_levels)
+    {
+        compile(pattern.m_source);
+    }
+
+    /**
+     * @brief Assignment operator.
+     *
+     * @param pattern Pattern to copy.
+     * @return Reference to this pattern.
+     */
+    auto operator=(Pattern const& pattern) -> Pattern&
+    {
+        if (this != &pattern) {
+            m_levels = pattern.m_levels;
+            compile(pattern.m_source);
+        }
+        return *this;
+    }
+
+    Pattern(Pattern&&) = delete;
+    auto operator=(Pattern&&) -> Pattern& = delete;
+
+    /** @brief Destroys the Pattern object. */
+    ~Pattern() = default;
+
     /**
      * @brief Checks if the pattern is empty.
      *
@@ -363,6 +397,7 @@ private:
     constexpr static void
     write_string_padded(auto& dst, StringView&& src, const Placeholder::StringSpecs& specs);
 
+    std::basic_string<Char> m_source;
     std::basic_string<Char> m_pattern;
     std::vector<Placeholder> m_placeholders;
     Levels m_levels;
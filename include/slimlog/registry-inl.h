@@ -0,0 +1,154 @@
+/**
+ * @file registry-inl.h
+ * @brief Contains definition of Registry class.
+ */
+
+#pragma once
+
+// IWYU pragma: private, include "slimlog/registry.h"
+
+#include "slimlog/registry.h" // IWYU pragma: associated
+#include "slimlog/util/hash.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+namespace SlimLog {
+
+template<typename Logger>
+Registry<Logger>::Registry(StringViewType category, Level level)
+    : m_root(BorrowCategoryTag, intern(category), level)
+{
+    m_table = m_tables.emplace_back(std::make_unique<Table>(InitialCapacity)).get();
+    insert(*m_table, &m_root, hash(m_root.category()));
+}
+
+template<typename Logger>
+auto Registry<Logger>::get(StringViewType category) -> Logger&
+{
+    const auto category_hash = hash(category);
+    if (auto* logger = find(*m_table.load(std::memory_order_acquire), category, category_hash)) {
+        return *logger;
+    }
+
+    const std::lock_guard lock(m_mutex);
+    auto* table = m_table.load(std::memory_order_relaxed);
+    if (auto* logger = find(*table, category, category_hash)) {
+        return *logger;
+    }
+
+    // Keep the load factor under one half, readers of the old table see the old entries
+    if ((table->size + 1) * 2 > table->slots.size()) {
+        auto grown = std::make_unique<Table>(table->slots.size() * 2);
+        for (const auto& slot : table->slots) {
+            if (auto* logger = slot.logger.load(std::memory_order_relaxed)) {
+                insert(*grown, logger, slot.hash.load(std::memory_order_relaxed));
+            }
+        }
+        table = m_tables.emplace_back(std::move(grown)).get();
+        m_table.store(table, std::memory_order_release);
+    }
+
+    auto& logger = m_loggers.emplace_back(BorrowCategoryTag, intern(category), m_root);
+    if (m_filter) {
+        logger.set_level(m_filter->level(logger.category()));
+    }
+    insert(*table, &logger, category_hash);
+    return logger;
+}
+
+template<typename Logger>
+auto Registry<Logger>::find(StringViewType category) const noexcept -> Logger*
+{
+    return find(*m_table.load(std::memory_order_acquire), category, hash(category));
+}
+
+template<typename Logger>
+auto Registry<Logger>::set_level(StringViewType prefix, Level level) -> void
+{
+    const auto matches = [prefix](StringViewType category) {
+        return category.starts_with(prefix)
+            && (prefix.empty() || category.size() == prefix.size()
+                || category[prefix.size()] == CharType{'.'});
+    };
+
+    const std::lock_guard lock(m_mutex);
+    if (matches(m_root.category())) {
+        m_root.set_level(level);
+    }
+    for (auto& logger : m_loggers) {
+        if (matches(logger.category())) {
+            logger.set_level(level);
+        }
+    }
+}
+
+template<typename Logger>
+auto Registry<Logger>::set_levels(const CategoryFilter<CharType>& filter) -> void
+{
+    auto rules = std::make_unique<const CategoryFilter<CharType>>(filter);
+    const std::lock_guard lock(m_mutex);
+    m_filter = std::move(rules);
+    m_root.set_levels(*m_filter);
+}
+
+template<typename Logger>
+auto Registry<Logger>::hash(StringViewType category) noexcept -> std::uint64_t
+{
+    return Util::Hash::hash64(category.data(), category.size() * sizeof(CharType));
+}
+
+template<typename Logger>
+auto Registry<Logger>::find(
+    const Table& table, StringViewType category, std::uint64_t hash) noexcept -> Logger*
+{
+    const auto mask = table.slots.size() - 1;
+    for (auto index = hash & mask;; index = (index + 1) & mask) {
+        const auto& slot = table.slots[index];
+        // Logger is published after the hash, so the hash is valid once the logger is seen
+        auto* logger = slot.logger.load(std::memory_order_acquire);
+        if (logger == nullptr) {
+            return nullptr;
+        }
+        if (slot.hash.load(std::memory_order_relaxed) == hash && logger->category() == category) {
+            return logger;
+        }
+    }
+}
+
+template<typename Logger>
+auto Registry<Logger>::insert(Table& table, Logger* logger, std::uint64_t hash) -> void
+{
+    const auto mask = table.slots.size() - 1;
+    auto index = hash & mask;
+    while (table.slots[index].logger.load(std::memory_order_relaxed) != nullptr) {
+        index = (index + 1) & mask;
+    }
+    table.slots[index].hash.store(hash, std::memory_order_relaxed);
+    table.slots[index].logger.store(logger, std::memory_order_release);
+    ++table.size;
+}
+
+template<typename Logger>
+auto Registry<Logger>::intern(StringViewType category) -> StringViewType
+{
+    if (category.empty()) {
+        return {};
+    }
+
+    if (m_arena_used + category.size() > ArenaChunkSize) {
+        // Strings longer than the chunk get a chunk of their own
+        m_arena.push_back(std::make_unique<CharType[]>( // NOLINT(*-avoid-c-arrays)
+            std::max(category.size(), ArenaChunkSize)));
+        m_arena_used = 0;
+    }
+    auto* data = std::next(m_arena.back().get(), static_cast<std::ptrdiff_t>(m_arena_used));
+    m_arena_used += category.size();
+
+    std::copy(category.begin(), category.end(), data);
+    return {data, category.size()};
+}
+
+} // namespace SlimLog
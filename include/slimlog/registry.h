@@ -0,0 +1,220 @@
+/**
+ * @file registry.h
+ * @brief Contains declaration of Registry class.
+ */
+
+#pragma once
+
+#include "slimlog/category_filter.h"
+#include "slimlog/level.h"
+#include "slimlog/logger.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace SlimLog {
+
+/**
+ * @brief Registry of loggers by category.
+ *
+ * Creates the loggers on the first request and hands out stable references to them
+ * afterwards. All registered loggers are children of the root logger, so the sinks
+ * added to the root are shared by all of them. Category strings are interned into
+ * a single arena and borrowed by the loggers, so each category is stored once.
+ *
+ * Lookups of the existing loggers are lock-free: the hash table is read with atomic
+ * loads only, new entries are inserted in place under a mutex, and a grown table
+ * is published with one atomic pointer swap.
+ *
+ * Usage example:
+ * ```cpp
+ * auto& registry = Log::Registry<Log::Logger<std::string_view>>::global();
+ * registry.root().add_sink<Log::OStreamSink>(std::cerr);
+ * registry.get("net.http").info("Connected");
+ * registry.set_level("net", Log::Level::Debug);
+ * ```
+ *
+ * @tparam Logger Logger type.
+ */
+template<typename Logger>
+class Registry {
+public:
+    /** @brief Logger type. */
+    using LoggerType = Logger;
+    /** @brief Character type for the categories. */
+    using CharType = typename Logger::CharType;
+    /** @brief String view type for the categories. */
+    using StringViewType = typename Logger::StringViewType;
+
+    /**
+     * @brief Constructs a new Registry object.
+     *
+     * @param category Category of the root logger.
+     * @param level Logging level of the root logger.
+     */
+    explicit Registry(StringViewType category = {}, Level level = Level::Info);
+
+    Registry(Registry const&) = delete;
+    Registry(Registry&&) = delete;
+    auto operator=(Registry const&) -> Registry& = delete;
+    auto operator=(Registry&&) -> Registry& = delete;
+
+    /** @brief Destroys the Registry object and all registered loggers. */
+    ~Registry() = default;
+
+    /**
+     * @brief Gets the process-wide registry.
+     *
+     * @return Reference to the registry with the empty root category.
+     */
+    static auto global() -> Registry&
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    /**
+     * @brief Gets the root logger.
+     *
+     * @return Reference to the root logger.
+     */
+    auto root() -> Logger&
+    {
+        return m_root;
+    }
+
+    /**
+     * @brief Gets the logger of the category, creating it if needed.
+     *
+     * A new logger inherits the sinks of the root logger. Its logging level is taken from
+     * the filter passed to set_levels() most recently, or from the root logger if there
+     * was none.
+     *
+     * @param category Logger category.
+     * @return Reference to the logger, valid for the lifetime of the registry.
+     */
+    auto get(StringViewType category) -> Logger&;
+
+    /**
+     * @brief Finds the logger of the category.
+     *
+     * @param category Logger category.
+     * @return Pointer to the logger or `nullptr` if it is not registered.
+     */
+    [[nodiscard]] auto find(StringViewType category) const noexcept -> Logger*;
+
+    /**
+     * @brief Sets the logging level of the registered loggers by category prefix.
+     *
+     * The prefix matches the category itself and its subcategories
+     * (`"net"` matches `"net"` and `"net.http"`, but not `"network"`).
+     * Empty prefix matches all loggers, including the root one.
+     *
+     * @param prefix Category prefix.
+     * @param level Logging level.
+     */
+    auto set_level(StringViewType prefix, Level level) -> void;
+
+    /**
+     * @brief Sets the logging levels of all registered loggers from the category filter.
+     *
+     * The registry keeps a copy of the rules, so the loggers created later get
+     * their levels from the same rules.
+     *
+     * @param filter Category filter.
+     */
+    auto set_levels(const CategoryFilter<CharType>& filter) -> void;
+
+private:
+    /** @brief Initial number of the hash table slots. */
+    static constexpr std::size_t InitialCapacity = 64;
+    /** @brief Size of the category arena chunk in characters. */
+    static constexpr std::size_t ArenaChunkSize = 4096;
+
+    /**
+     * @brief Hash table slot.
+     */
+    struct Slot {
+        std::atomic<std::uint64_t> hash = 0; ///< Category hash.
+        std::atomic<Logger*> logger = nullptr; ///< Logger (`nullptr` if unused).
+    };
+
+    /**
+     * @brief Open addressing hash table.
+     */
+    struct Table {
+        /**
+         * @brief Constructs a new Table object.
+         *
+         * @param capacity Number of slots (power of two).
+         */
+        explicit Table(std::size_t capacity)
+            : slots(capacity)
+        {
+        }
+
+        std::vector<Slot> slots; ///< Slots.
+        std::size_t size = 0; ///< Number of used slots.
+    };
+
+    /**
+     * @brief Computes the category hash.
+     *
+     * @param category Logger category.
+     * @return Hash value.
+     */
+    static auto hash(StringViewType category) noexcept -> std::uint64_t;
+
+    /**
+     * @brief Finds the logger in the table.
+     *
+     * @param table Hash table.
+     * @param category Logger category.
+     * @param hash Category hash.
+     * @return Pointer to the logger or `nullptr` if not found.
+     */
+    static auto find(const Table& table, StringViewType category, std::uint64_t hash) noexcept
+        -> Logger*;
+
+    /**
+     * @brief Inserts the logger into the table, which must have a free slot.
+     *
+     * Has to be called with the mutex locked.
+     *
+     * @param table Hash table.
+     * @param logger Logger to insert.
+     * @param hash Category hash.
+     */
+    static auto insert(Table& table, Logger* logger, std::uint64_t hash) -> void;
+
+    /**
+     * @brief Copies the string into the arena.
+     *
+     * Has to be called with the mutex locked.
+     *
+     * @param category Logger category.
+     * @return View of the interned string, valid for the lifetime of the registry.
+     */
+    auto intern(StringViewType category) -> StringViewType;
+
+    std::vector<std::unique_ptr<CharType[]>> m_arena; // NOLINT(*-avoid-c-arrays)
+    std::size_t m_arena_used = ArenaChunkSize;
+    std::vector<std::unique_ptr<Table>> m_tables;
+    std::atomic<Table*> m_table = nullptr;
+    std::unique_ptr<const CategoryFilter<CharType>> m_filter;
+    std::mutex m_mutex;
+    Logger m_root;
+    // Registered loggers are destroyed before the root one
+    std::deque<Logger> m_loggers;
+};
+} // namespace SlimLog
+
+#ifdef SLIMLOG_HEADER_ONLY
+#include "slimlog/registry-inl.h" // IWYU pragma: keep
+#endif
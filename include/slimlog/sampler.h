@@ -0,0 +1,150 @@
+/**
+ * @file sampler.h
+ * @brief Contains the definition of the Sampler class.
+ */
+
+#pragma once
+
+#include "slimlog/format.h"
+#include "slimlog/record.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace SlimLog {
+
+/**
+ * @brief Format string of the summary for suppressed messages.
+ *
+ * @tparam Char Character type of the format string.
+ */
+template<typename Char>
+inline constexpr std::array<Char, 23> SuppressedFormat{
+    'S', 'u', 'p', 'p', 'r', 'e', 's', 's', 'e', 'd', ' ', '{',
+    '}', ' ', 'm', 'e', 's', 's', 'a', 'g', 'e', 's', '\0'};
+
+/**
+ * @brief Passes the summary of suppressed messages to the sink.
+ *
+ * The summary takes level, location, category, thread and time of the \p origin record.
+ *
+ * @tparam SinkType Target sink type.
+ * @tparam Char Character type of the format string.
+ * @tparam N Size of the format string.
+ * @param target Sink receiving the summary.
+ * @param origin Record the summary is attributed to.
+ * @param format Summary format string with a single argument (e.g., SuppressedFormat).
+ * @param count Number of suppressed messages.
+ */
+template<typename SinkType, typename Char, std::size_t N>
+auto forward_summary(
+    SinkType& target,
+    const typename SinkType::RecordType& origin,
+    const std::array<Char, N>& format,
+    std::uint64_t count) -> void
+{
+    constexpr std::size_t SummarySize = 64;
+    FormatBuffer<Char, SummarySize> buffer;
+    buffer.vformat(
+        std::basic_string_view<Char>{format.data()},
+        FormatBuffer<Char, SummarySize>::make_format_args(count));
+
+    typename SinkType::RecordType summary = {
+        origin.level, origin.location, origin.category, origin.thread_id, origin.time};
+    summary.message = RecordStringView<Char>(buffer.data(), buffer.size());
+    target.deliver(summary);
+}
+
+/**
+ * @brief Per-call-site sampling state.
+ *
+ * Decides whether a message from a particular call site has to be emitted.
+ * Supposed to be declared as a static variable at the call site
+ * (see `SLIMLOG_EVERY_N`, `SLIMLOG_ONCE` and `SLIMLOG_RATE_LIMITED` macros),
+ * so that a suppressed message costs a single atomic operation.
+ * Each sampler object has to be used with one sampling method only.
+ */
+class Sampler final {
+public:
+    /**
+     * @brief Lets through every \p n -th message, starting with the first one.
+     *
+     * @param n Sampling interval.
+     * @return Number of messages suppressed since the previous emitted one,
+     *         or `std::nullopt` if this message has to be suppressed.
+     */
+    [[nodiscard]] auto every_n(std::uint64_t n) noexcept -> std::optional<std::uint64_t>
+    {
+        n = std::max<std::uint64_t>(n, 1);
+        const auto count = m_counter.fetch_add(1, std::memory_order_relaxed);
+        if (count % n != 0) {
+            return std::nullopt;
+        }
+        return count == 0 ? 0 : n - 1;
+    }
+
+    /**
+     * @brief Lets through the first message only.
+     *
+     * @return Zero for the first message, `std::nullopt` for all others.
+     */
+    [[nodiscard]] auto once() noexcept -> std::optional<std::uint64_t>
+    {
+        if (m_counter.load(std::memory_order_relaxed) != 0
+            || m_counter.exchange(1, std::memory_order_relaxed) != 0) {
+            return std::nullopt;
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Lets through at most \p per_second messages (or other units) per second.
+     *
+     * Uses the generic cell rate algorithm: the state is a single timestamp of
+     * the theoretical arrival time of the next message, bursts up to one second
+     * worth of units are allowed.
+     *
+     * @param per_second Maximum rate.
+     * @param cost Number of units consumed by this message (e.g., its size for byte budgets).
+     * @return Number of messages suppressed since the previous emitted one,
+     *         or `std::nullopt` if this message has to be suppressed.
+     */
+    [[nodiscard]] auto rate_limited(double per_second, std::uint64_t cost = 1) noexcept
+        -> std::optional<std::uint64_t>
+    {
+        constexpr std::int64_t NsecInSec = 1000000000;
+        const auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::steady_clock::now().time_since_epoch())
+                             .count();
+        const auto interval = per_second > 0
+            ? static_cast<std::int64_t>(
+                  static_cast<double>(cost) * static_cast<double>(NsecInSec) / per_second)
+            : NsecInSec;
+        const auto tolerance = std::max(interval, NsecInSec);
+
+        auto arrival = m_arrival.load(std::memory_order_relaxed);
+        for (;;) {
+            const auto next = std::max(arrival, now) + interval;
+            if (next - now > tolerance) {
+                m_counter.fetch_add(1, std::memory_order_relaxed);
+                return std::nullopt;
+            }
+            if (m_arrival.compare_exchange_weak(arrival, next, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        return m_counter.exchange(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<std::uint64_t> m_counter = 0;
+    std::atomic<std::int64_t> m_arrival = 0;
+};
+
+} // namespace SlimLog
@@ -8,37 +8,110 @@
 // IWYU pragma: private, include "slimlog/sink.h"
 
 #include "slimlog/sink.h" // IWYU pragma: associated
-#include "slimlog/util/os.h"
 
 #include <algorithm>
 #include <iterator>
-#include <tuple>
+#include <string_view>
 
 namespace SlimLog {
 
+template<typename String, typename Char>
+Sink<String, Char>::Sink(Sink const& sink)
+    : m_level(sink.level())
+    , m_filters(copy_filters(sink))
+{
+}
+
+template<typename String, typename Char>
+Sink<String, Char>::Sink(Sink&& sink) noexcept
+    : m_level(sink.level())
+{
+    // The moved-from sink has no concurrent readers, so there is no grace period to wait for
+    m_filters.swap(sink.m_filters);
+}
+
+template<typename String, typename Char>
+auto Sink<String, Char>::operator=(Sink const& sink) -> Sink&
+{
+    if (this != &sink) {
+        set_level(sink.level());
+        m_filters.update(copy_filters(sink));
+    }
+    return *this;
+}
+
+template<typename String, typename Char>
+auto Sink<String, Char>::operator=(Sink&& sink) noexcept -> Sink&
+{
+    if (this != &sink) {
+        set_level(sink.level());
+        m_filters.swap(sink.m_filters);
+    }
+    return *this;
+}
+
+template<typename String, typename Char>
+auto Sink<String, Char>::set_filters(std::vector<FilterRuleType> rules) -> void
+{
+    // The replaced chain is destroyed once the concurrent readers are done with it
+    m_filters.update(
+        rules.empty() ? nullptr : std::make_unique<const FilterChain>(std::move(rules)));
+}
+
+template<typename String, typename Char>
+auto Sink<String, Char>::copy_filters(const Sink& sink) -> std::unique_ptr<const FilterChain>
+{
+    const auto filters = sink.m_filters.read();
+    return filters.get() ? std::make_unique<const FilterChain>(*filters) : nullptr;
+}
+
+template<typename String, typename Char>
+auto Sink<String, Char>::filter(
+    const FilterChain& filters,
+    Level level,
+    std::basic_string_view<Char> category,
+    const char* file) noexcept -> bool
+{
+    for (const auto& rule : filters) {
+        if (rule.level < level || !category.starts_with(rule.category)) {
+            continue;
+        }
+        if (!rule.file.empty()
+            && (file == nullptr || !std::string_view{file}.ends_with(rule.file))) {
+            continue;
+        }
+        return rule.action == FilterAction::Accept;
+    }
+    return true;
+}
+
 template<typename String, typename Char, std::size_t BufferSize, typename Allocator>
 auto FormattableSink<String, Char, BufferSize, Allocator>::set_levels(
     std::initializer_list<std::pair<Level, StringViewType>> levels) -> void
 {
-    m_pattern.set_levels(std::move(levels));
+    m_pattern.modify([levels](Pattern<Char>& pattern) { pattern.set_levels(levels); });
 }
 
 template<typename String, typename Char, std::size_t BufferSize, typename Allocator>
 auto FormattableSink<String, Char, BufferSize, Allocator>::set_pattern(StringViewType pattern)
     -> void
 {
-    m_pattern.set_pattern(std::move(pattern));
+    m_pattern.modify([pattern](Pattern<Char>& value) { value.set_pattern(pattern); });
 }
 
 template<typename String, typename Char, std::size_t BufferSize, typename Allocator>
 auto FormattableSink<String, Char, BufferSize, Allocator>::format(
     FormatBufferType& result, RecordType& record) -> void
 {
-    m_pattern.format(result, record);
+    const Tracer::Scope trace(Stage::SinkFormat);
+    m_pattern.read()->format(result, record);
+    if (result.heap_allocated()) [[unlikely]] {
+        this->counters().grown();
+    }
 }
 
 template<typename Logger, typename ThreadingPolicy>
-SinkDriver<Logger, ThreadingPolicy>::SinkDriver(const Logger* logger, SinkDriver* parent)
+SinkDriver<Logger, ThreadingPolicy>::SinkDriver(Logger* logger, SinkDriver* parent)
     : m_logger(logger)
     , m_parent(parent)
 {
@@ -104,6 +177,56 @@ auto SinkDriver<Logger, ThreadingPolicy>::sink_enabled(const std::shared_ptr<Sin
     return false;
 }
 
+template<typename Logger, typename ThreadingPolicy>
+auto SinkDriver<Logger, ThreadingPolicy>::vmessage(
+    Level level,
+    StringViewType category,
+    Location location,
+    StringViewType fmt,
+    FormatArgs<typename StringViewType::value_type> args) const -> void
+{
+    message(
+        level,
+        [fmt, &args](FormatBufferType& buffer) { buffer.vformat(fmt, args); },
+        category,
+        location);
+}
+
+template<typename Logger, typename ThreadingPolicy>
+auto SinkDriver<Logger, ThreadingPolicy>::emit(
+    Level level,
+    StringViewType category,
+    Location location,
+    RecordTime time,
+    RecordStringViewType message) const -> void
+{
+    const auto bytes = message.size() * sizeof(typename RecordStringViewType::value_type);
+    RecordType record;
+    {
+        const Tracer::Scope trace(Stage::CreateRecord);
+        record = create_record(level, category, location);
+    }
+    record.time = time;
+    record.message = std::move(message);
+
+    bool emitted = false;
+    const typename ThreadingPolicy::ReadLock lock(m_mutex);
+    for (const auto& sink : m_effective_sinks) {
+        if (sink.first->accepts(level, category, location.file_name())) {
+            emitted = true;
+            sink.first->m_counters.record();
+            sink.first->message(record);
+        }
+    }
+
+    // The message has been formatted earlier, its buffer growth is not known here
+    if (emitted) {
+        m_counters.emitted(level, bytes, false);
+    } else {
+        m_counters.filtered();
+    }
+}
+
 template<typename Logger, typename ThreadingPolicy>
 auto SinkDriver<Logger, ThreadingPolicy>::parent() -> SinkDriver*
 {
@@ -143,8 +266,8 @@ auto SinkDriver<Logger, ThreadingPolicy>::create_record(
         level,
         {location.file_name(), location.function_name(), static_cast<std::size_t>(location.line())},
         std::move(category),
-        Util::OS::thread_id()};
-    std::tie(record.time.local, record.time.nsec) = Util::OS::local_time();
+        Logger::ClockType::thread_id(),
+        Logger::ClockType::now()};
     return record;
 }
 
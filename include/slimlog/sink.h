@@ -8,21 +8,77 @@
 #include "slimlog/format.h"
 #include "slimlog/level.h"
 #include "slimlog/location.h"
+#include "slimlog/metrics.h"
 #include "slimlog/pattern.h"
 #include "slimlog/record.h"
+#include "slimlog/tracing.h"
+#include "slimlog/util/rcu.h"
 #include "slimlog/util/types.h"
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <initializer_list>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <string_view>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
+#include <variant>
 #include <vector>
 
 namespace SlimLog {
 
+template<typename Logger, typename ThreadingPolicy>
+class SinkDriver;
+
+/**
+ * @brief Action of the sink filter rule.
+ */
+enum class FilterAction : std::uint8_t {
+    Accept, ///< Pass the matching record to the sink.
+    Reject ///< Drop the matching record.
+};
+
+/**
+ * @brief Sink filter rule.
+ *
+ * Matches log records by category prefix, level and source file name.
+ *
+ * @tparam Char Character type for the category.
+ */
+template<typename Char>
+struct FilterRule {
+    /**
+     * @brief Constructs a new FilterRule object.
+     *
+     * @param action Action for the matching records.
+     * @param category Category prefix (empty matches any category).
+     * @param level Most verbose matching level.
+     * @param file Source file name (empty matches any file).
+     */
+    // NOLINTNEXTLINE(*-explicit-constructor,*-explicit-conversions)
+    FilterRule(
+        FilterAction action = FilterAction::Accept,
+        std::basic_string<Char> category = {},
+        Level level = Level::Trace,
+        std::string file = {})
+        : action(action)
+        , category(std::move(category))
+        , level(level)
+        , file(std::move(file))
+    {
+    }
+
+    FilterAction action; ///< Action for the matching records.
+    std::basic_string<Char> category; ///< Category prefix.
+    Level level; ///< Most verbose matching level.
+    std::string file; ///< Source file name.
+};
+
 /**
  * @brief Base abstract sink class.
  *
@@ -36,22 +92,90 @@ class Sink {
 public:
     /** @brief Log record type. */
     using RecordType = Record<Char, String>;
+    /** @brief Filter rule type. */
+    using FilterRuleType = FilterRule<Char>;
 
     /** @brief Default constructor. */
     Sink() = default;
     /** @brief Copy constructor. */
-    Sink(Sink const&) = default;
+    Sink(Sink const& sink);
     /** @brief Move constructor. */
-    Sink(Sink&&) noexcept = default;
+    Sink(Sink&& sink) noexcept;
 
     /** @brief Assignment operator. */
-    auto operator=(Sink const&) -> Sink& = default;
+    auto operator=(Sink const& sink) -> Sink&;
     /** @brief Move assignment operator. */
-    auto operator=(Sink&&) noexcept -> Sink& = default;
+    auto operator=(Sink&& sink) noexcept -> Sink&;
 
     /** @brief Destructor. */
     virtual ~Sink() = default;
 
+    /**
+     * @brief Sets the sink logging level.
+     *
+     * The sink receives only records which pass both the logger and the sink levels.
+     *
+     * @param level Level to be set for this sink (e.g., Log::Level::Error).
+     */
+    auto set_level(Level level) -> void
+    {
+        m_level.store(level, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Gets the sink logging level.
+     *
+     * @return Logging level for this sink.
+     */
+    [[nodiscard]] auto level() const -> Level
+    {
+        return m_level.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Sets the filter chain.
+     *
+     * Rules are checked in order, the first rule matching the record decides
+     * whether the record is accepted. Records which match no rule are accepted.
+     * An empty list removes the filter chain.
+     *
+     * Usage example:
+     * ```cpp
+     * // Only warnings and errors from the "net" subsystem, except the noisy client
+     * sink->set_filters({
+     *     {Log::FilterAction::Reject, "net.client"},
+     *     {Log::FilterAction::Accept, "net", Log::Level::Warning},
+     *     {Log::FilterAction::Reject}});
+     * ```
+     *
+     * @param rules Filter rules.
+     */
+    auto set_filters(std::vector<FilterRuleType> rules) -> void;
+
+    /**
+     * @brief Checks if the record has to be passed to the sink.
+     *
+     * Called before the message is evaluated and formatted.
+     *
+     * @param level Record level.
+     * @param category Record category.
+     * @param file Source file name.
+     * @return \b true if the record passes the sink level and filter chain.
+     */
+    [[nodiscard]] auto accepts(Level level, std::basic_string_view<Char> category, const char* file)
+        const noexcept -> bool
+    {
+        if (m_level.load(std::memory_order_relaxed) < level) {
+            return false;
+        }
+        // Sinks without filters skip the read section
+        if (m_filters.empty()) {
+            return true;
+        }
+        const auto filters = m_filters.read();
+        return filters.get() == nullptr || filter(*filters, level, category, file);
+    }
+
     /**
      * @brief Processes a log record.
      *
@@ -61,10 +185,106 @@ public:
      */
     virtual auto message(RecordType& record) -> void = 0;
 
+    /**
+     * @brief Passes a log record forwarded by another sink.
+     *
+     * Checks the sink level and filter chain and counts the record the same way
+     * the logger does before calling message(). Used by the wrapper sinks.
+     *
+     * @param record The log record to process.
+     */
+    auto deliver(RecordType& record) -> void
+    {
+        if (!accepts(record.level, record.category, record.location.filename.data())) {
+            return;
+        }
+        m_counters.record();
+        message(record);
+    }
+
     /**
      * @brief Flushes any buffered log messages.
      */
     virtual auto flush() -> void = 0;
+
+    /**
+     * @brief Reads the sink metrics without locking.
+     *
+     * @return Metrics snapshot, all zeros if `SLIMLOG_METRICS` is not defined.
+     */
+    [[nodiscard]] auto metrics() const noexcept -> SinkMetrics
+    {
+        return m_counters.snapshot();
+    }
+
+protected:
+    /**
+     * @brief Gets the sink counters updated by the derived sinks.
+     *
+     * @return Sink counters.
+     */
+    auto counters() noexcept -> SinkCounters&
+    {
+        return m_counters;
+    }
+
+    /**
+     * @brief Gets the message of the log record as a string view.
+     *
+     * @param record The log record.
+     * @return Message string view.
+     * @throws FormatError if there is no ConvertString<> specialization for the string type.
+     */
+    static auto message_view(const RecordType& record) -> std::basic_string_view<Char>
+    {
+        return std::visit(
+            Util::Types::Overloaded{
+                [](std::reference_wrapper<const String> arg) -> std::basic_string_view<Char> {
+                    if constexpr (requires { ConvertString<Char, String>{}(arg.get()); }) {
+                        return ConvertString<Char, String>{}(arg.get());
+                    } else {
+                        (void)arg;
+                        throw FormatError(
+                            "No corresponding Log::ConvertString<> specialization found");
+                    }
+                },
+                [](const auto& arg) -> std::basic_string_view<Char> { return arg; },
+            },
+            record.message);
+    }
+
+private:
+    using FilterChain = std::vector<FilterRuleType>;
+
+    /**
+     * @brief Evaluates the filter chain.
+     *
+     * @param filters Filter chain.
+     * @param level Record level.
+     * @param category Record category.
+     * @param file Source file name.
+     * @return \b true if the record is accepted.
+     */
+    static auto filter(
+        const FilterChain& filters,
+        Level level,
+        std::basic_string_view<Char> category,
+        const char* file) noexcept -> bool;
+
+    /**
+     * @brief Copies the filter chain of another sink.
+     *
+     * @param sink Source sink.
+     * @return Filter chain copy, null if the sink has no filters.
+     */
+    static auto copy_filters(const Sink& sink) -> std::unique_ptr<const FilterChain>;
+
+    template<typename, typename>
+    friend class SinkDriver;
+
+    std::atomic<Level> m_level = Level::Trace;
+    Util::RcuPointer<const FilterChain> m_filters{nullptr};
+    [[no_unique_address]] SinkCounters m_counters;
 };
 
 /**
@@ -115,13 +335,16 @@ public:
     template<typename... Args>
     explicit FormattableSink(Args&&... args)
         // NOLINTNEXTLINE(*-array-to-pointer-decay,*-no-array-decay)
-        : m_pattern(std::forward<Args>(args)...)
+        : m_pattern(std::make_unique<Pattern<Char>>(std::forward<Args>(args)...))
     {
     }
 
     /**
      * @brief Sets the log message pattern.
      *
+     * The new pattern is compiled off to the side and published atomically,
+     * so the messages being formatted concurrently are not affected.
+     *
      * Usage example:
      * ```cpp
      * Log::Logger log("test", Log::Level::Info);
@@ -136,6 +359,9 @@ public:
     /**
      * @brief Sets the log level names.
      *
+     * The names are published atomically along with a copy of the pattern.
+     * The strings have to outlive the sink.
+     *
      * Usage example:
      * ```cpp
      * Log::Logger log("test", Log::Level::Info);
@@ -157,7 +383,7 @@ protected:
     auto format(FormatBufferType& result, RecordType& record) -> void;
 
 private:
-    Pattern<Char> m_pattern;
+    Util::RcuPointer<Pattern<Char>> m_pattern;
 };
 
 /**
@@ -202,7 +428,7 @@ public:
      * @param logger Pointer to the logger.
      * @param parent Pointer to the parent instance (if any).
      */
-    explicit SinkDriver(const Logger* logger, SinkDriver* parent = nullptr);
+    explicit SinkDriver(Logger* logger, SinkDriver* parent = nullptr);
 
     SinkDriver(const SinkDriver&) = delete;
     SinkDriver(SinkDriver&&) = delete;
@@ -290,21 +516,30 @@ public:
         Location location = Location::current(), // cppcheck-suppress passedByValue
         Args&&... args) const -> void
     {
+        const auto start = Tracer::now();
         FormatBufferType buffer; // NOLINT(misc-const-correctness)
-        RecordType record = create_record(level, std::move(category), location);
+        RecordType record;
 
         // Flag to check that message has been evaluated
         bool evaluated = false;
 
         const typename ThreadingPolicy::ReadLock lock(m_mutex);
         for (const auto& [sink, logger] : m_effective_sinks) {
-            if (!logger->level_enabled(level)) [[unlikely]] {
+            // Sink level and filters are checked before the message is evaluated
+            if (!logger->level_enabled(level)
+                || !sink->accepts(level, category, location.file_name())) [[unlikely]] {
                 continue;
             }
 
             if (!evaluated) [[unlikely]] {
                 evaluated = true;
+                Tracer::record(Stage::LevelCheck, start);
+                {
+                    const Tracer::Scope trace(Stage::CreateRecord);
+                    record = create_record(level, category, location);
+                }
 
+                const Tracer::Scope trace(Stage::Format);
                 using BufferRefType = std::add_lvalue_reference_t<FormatBufferType>;
                 if constexpr (std::is_invocable_v<T, BufferRefType, Args...>) {
                     // Callable with buffer argument: message will be stored in buffer.
@@ -334,8 +569,92 @@ public:
                 }
             }
 
+            sink->m_counters.record();
             sink->message(record);
         }
+
+        if (!evaluated) {
+            Tracer::record(Stage::LevelCheck, start);
+            m_counters.filtered();
+        } else {
+            using BufferRefType = std::add_lvalue_reference_t<FormatBufferType>;
+            if constexpr (std::is_invocable_v<T, BufferRefType, Args...>) {
+                m_counters.emitted(
+                    level,
+                    buffer.size() * sizeof(typename FormatBufferType::value_type),
+                    buffer.heap_allocated());
+            } else {
+                m_counters.emitted(level, 0, false);
+            }
+        }
+    }
+
+    /**
+     * @brief Emits a new formatted log message if it fits the specified logging level.
+     *
+     * Non-template counterpart of message() for the formatted messages: the call sites
+     * only pack the arguments, while the sink loop, the record creation and the formatting
+     * are compiled once per logger type. The arguments are formatted only if some sink
+     * accepts the message.
+     *
+     * @param level Logging level.
+     * @param category Logger category.
+     * @param location Caller location (file, line, function).
+     * @param fmt Format string.
+     * @param args Type-erased format arguments.
+     */
+    auto vmessage(
+        Level level,
+        StringViewType category,
+        Location location,
+        StringViewType fmt,
+        FormatArgs<typename StringViewType::value_type> args) const -> void;
+
+    /**
+     * @brief Emits an already prepared message to all sinks regardless of the logger levels.
+     *
+     * Sink levels and filters are still applied.
+     * Used to replay messages which were held back earlier (see Backtrace).
+     *
+     * @param level Logging level.
+     * @param category Logger category.
+     * @param location Caller location (file, line, function).
+     * @param time Time of the original message.
+     * @param message Log message.
+     */
+    auto emit(
+        Level level,
+        StringViewType category,
+        Location location,
+        RecordTime time,
+        RecordStringViewType message) const -> void;
+
+    /**
+     * @brief Reads the metrics of the messages emitted through this driver without locking.
+     *
+     * @return Metrics snapshot, all zeros if `SLIMLOG_METRICS` is not defined.
+     */
+    [[nodiscard]] auto metrics() const noexcept -> LoggerMetrics
+    {
+        return m_counters.snapshot();
+    }
+
+    /**
+     * @brief Calls the visitor for the logger and all its descendants.
+     *
+     * Loggers are visited in depth-first order, parents before children.
+     *
+     * @tparam Visitor Invocable type accepting the logger reference.
+     * @param visitor Visitor to call.
+     */
+    template<typename Visitor>
+    auto visit(Visitor& visitor) -> void
+    {
+        const typename ThreadingPolicy::ReadLock lock(m_mutex);
+        visitor(*m_logger);
+        for (auto* child : m_children) {
+            child->visit(visitor);
+        }
     }
 
 protected:
@@ -393,12 +712,13 @@ private:
      */
     auto update_effective_sinks(SinkDriver* driver) -> SinkDriver*;
 
-    const Logger* m_logger;
+    Logger* m_logger;
     SinkDriver* m_parent;
     std::vector<SinkDriver*> m_children;
     std::unordered_map<SinkType*, const Logger*> m_effective_sinks;
     std::unordered_map<std::shared_ptr<SinkType>, bool> m_sinks;
     mutable ThreadingPolicy::Mutex m_mutex;
+    [[no_unique_address]] mutable LoggerCounters m_counters;
 }; // namespace SlimLog
 
 } // namespace SlimLog
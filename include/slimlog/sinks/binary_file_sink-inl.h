@@ -0,0 +1,137 @@
+/**
+ * @file binary_file_sink-inl.h
+ * @brief Contains definition of BinaryFileSink class.
+ */
+
+#pragma once
+
+// IWYU pragma: private, include "slimlog/sinks/binary_file_sink.h"
+
+#include "slimlog/sinks/binary_file_sink.h" // IWYU pragma: associated
+
+#if defined(_WIN32) && defined(__STDC_WANT_SECURE_LIB__)
+// In addition to <cstdio> below for fopen_s() on Windows
+#include <stdio.h> // IWYU pragma: keep
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace SlimLog {
+
+template<typename String, typename Char>
+auto BinaryFileSink<String, Char>::open(std::string_view filename) -> void
+{
+#if defined(_WIN32) && defined(__STDC_WANT_SECURE_LIB__)
+    FILE* fp;
+    std::ignore = fopen_s(&fp, std::string(filename).c_str(), "wb");
+    m_fp = {fp, std::fclose};
+#else
+    m_fp = {std::fopen(std::string(filename).c_str(), "wb"), std::fclose};
+#endif
+    if (!m_fp) {
+        throw std::system_error({errno, std::system_category()}, "Error opening log file");
+    }
+
+    put(m_block, BinaryLogFormat::Magic);
+    put(m_block, BinaryLogFormat::Version);
+    put(m_block, static_cast<std::uint16_t>(sizeof(Char)));
+    if (std::fwrite(m_block.data(), m_block.size(), 1, m_fp.get()) != 1) {
+        throw std::system_error({errno, std::system_category()}, "Failed writing to log file");
+    }
+}
+
+template<typename String, typename Char>
+auto BinaryFileSink<String, Char>::message(RecordType& record) -> void
+{
+    const auto message = this->message_view(record);
+
+    constexpr std::int64_t NsecInSec = 1000000000;
+    const auto timestamp = static_cast<std::int64_t>(record.time.local.time_since_epoch().count())
+            * NsecInSec
+        + static_cast<std::int64_t>(record.time.nsec);
+
+    const Tracer::Scope trace(Stage::SinkWrite);
+    const std::lock_guard lock(m_mutex);
+    m_block.clear();
+    const auto id = site_id(record);
+    put(m_block, static_cast<std::uint8_t>(BinaryLogFormat::Entry::Record));
+    put(m_block, static_cast<std::uint8_t>(record.level));
+    put(m_block, id);
+    put(m_block, static_cast<std::uint64_t>(record.thread_id));
+    put(m_block, timestamp);
+    put_string<std::uint32_t>(m_block, message);
+
+    if (std::fwrite(m_block.data(), m_block.size(), 1, m_fp.get()) != 1) {
+        throw std::system_error({errno, std::system_category()}, "Failed writing to log file");
+    }
+    this->counters().written(m_block.size());
+}
+
+template<typename String, typename Char>
+auto BinaryFileSink<String, Char>::flush() -> void
+{
+    this->counters().flushed();
+    if (std::fflush(m_fp.get()) != 0) {
+        throw std::system_error({errno, std::system_category()}, "Failed flush to log file");
+    }
+}
+
+template<typename String, typename Char>
+auto BinaryFileSink<String, Char>::site_id(RecordType& record) -> std::uint32_t
+{
+    const CallSiteView key = {
+        record.location.filename.data(),
+        record.location.function.data(),
+        record.location.line,
+        std::basic_string_view<Char>{record.category}};
+
+    auto itr = m_sites.find(key);
+    if (itr == m_sites.end()) [[unlikely]] {
+        // The category is copied, as its storage may be reused for another category
+        CallSiteKey site{key.file, key.function, key.line, std::basic_string<Char>(key.category)};
+        const auto id = static_cast<std::uint32_t>(m_sites.size());
+        itr = m_sites.emplace(std::move(site), id).first;
+        put(m_block, static_cast<std::uint8_t>(BinaryLogFormat::Entry::CallSite));
+        put(m_block, itr->second);
+        put(m_block, static_cast<std::uint32_t>(record.location.line));
+        put_string<std::uint16_t>(m_block, std::string_view{record.location.filename});
+        put_string<std::uint16_t>(m_block, std::string_view{record.location.function});
+        put_string<std::uint16_t>(m_block, std::basic_string_view<Char>{record.category});
+    }
+    return itr->second;
+}
+
+template<typename String, typename Char>
+template<typename T>
+auto BinaryFileSink<String, Char>::put(Block& block, T value) -> void
+{
+    constexpr unsigned ByteBits = 8;
+    constexpr unsigned ByteMask = 0xFF;
+    const auto raw = static_cast<std::make_unsigned_t<T>>(value);
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        block.push_back(static_cast<unsigned char>((raw >> (i * ByteBits)) & ByteMask));
+    }
+}
+
+template<typename String, typename Char>
+template<typename Size, typename T>
+auto BinaryFileSink<String, Char>::put_string(Block& block, std::basic_string_view<T> str) -> void
+{
+    const auto size = std::min<std::size_t>(
+        str.size(), std::numeric_limits<Size>::max() / sizeof(T));
+    put(block, static_cast<Size>(size * sizeof(T)));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    const auto* data = reinterpret_cast<const unsigned char*>(str.data());
+    block.insert(block.end(), data, std::next(data, static_cast<std::ptrdiff_t>(size * sizeof(T))));
+}
+
+} // namespace SlimLog
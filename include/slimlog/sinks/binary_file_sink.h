@@ -0,0 +1,238 @@
+/**
+ * @file binary_file_sink.h
+ * @brief Contains declaration of BinaryFileSink class.
+ */
+
+#pragma once
+
+#include "slimlog/sink.h"
+#include "slimlog/util/types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace SlimLog {
+
+/**
+ * @brief Layout of the binary log files.
+ *
+ * All integers are little-endian. A file starts with a header:
+ *
+ * | Size | Description                           |
+ * |------|---------------------------------------|
+ * | 4    | Magic number `SLB1`                   |
+ * | 2    | Format version                        |
+ * | 2    | Character size of strings in bytes    |
+ *
+ * It is followed by a sequence of entries, each starting with a one-byte entry type.
+ * Call site entry is written once, before the first record referring to it:
+ *
+ * | Size | Description                           |
+ * |------|---------------------------------------|
+ * | 4    | Call site ID                          |
+ * | 4    | Line number                           |
+ * | 2+N  | File name (length-prefixed, bytes)    |
+ * | 2+N  | Function name (length-prefixed, bytes)|
+ * | 2+N  | Category (length-prefixed, bytes)     |
+ *
+ * Record entry:
+ *
+ * | Size | Description                           |
+ * |------|---------------------------------------|
+ * | 1    | Log level                             |
+ * | 4    | Call site ID                          |
+ * | 8    | Thread ID                             |
+ * | 8    | Local time in nanoseconds since epoch |
+ * | 4+N  | Message (length-prefixed, bytes)      |
+ */
+struct BinaryLogFormat {
+    /** @brief File magic number (`SLB1`). */
+    static constexpr std::uint32_t Magic = 0x31424C53;
+    /** @brief Format version. */
+    static constexpr std::uint16_t Version = 1;
+
+    /** @brief Entry types. */
+    enum class Entry : std::uint8_t {
+        CallSite = 1, ///< Call site metadata.
+        Record = 2 ///< Log record.
+    };
+};
+
+/**
+ * @brief Binary file sink.
+ *
+ * Writes log records in a compact binary form without any pattern formatting.
+ * Static call site information (file, function, line and category) is interned
+ * and written only once, each record refers to it by a numeric ID.
+ * Files can be converted back to text with the `slimlog-decode` tool.
+ *
+ * @tparam String String type for log messages.
+ * @tparam Char Character type for the string.
+ */
+template<typename String, typename Char = Util::Types::UnderlyingCharType<String>>
+class BinaryFileSink : public Sink<String, Char> {
+public:
+    using typename Sink<String, Char>::RecordType;
+
+    /**
+     * @brief Constructs a new BinaryFileSink object.
+     *
+     * @param filename Log file name.
+     */
+    explicit BinaryFileSink(std::string_view filename)
+    {
+        open(filename);
+    }
+
+    /**
+     * @brief Processes a log record.
+     *
+     * Encodes the log record and writes it to the file.
+     *
+     * @param record The log record to process.
+     */
+    auto message(RecordType& record) -> void override;
+
+    /**
+     * @brief Flushes the file.
+     */
+    auto flush() -> void override;
+
+protected:
+    /**
+     * @brief Opens a particular log file and writes the header.
+     *
+     * @param filename Log file name.
+     */
+    auto open(std::string_view filename) -> void;
+
+private:
+    using Block = std::vector<unsigned char>;
+
+    /**
+     * @brief Call site key.
+     *
+     * File and function names are compared by address, as they come from
+     * `std::source_location` and are static. The category is compared by contents:
+     * its storage may be reused by another category (e.g. after a logger is destroyed).
+     *
+     * @tparam Category Category string type, owning in the map and a view for the lookups.
+     */
+    template<typename Category>
+    struct CallSite {
+        const char* file; ///< File name.
+        const char* function; ///< Function name.
+        std::size_t line; ///< Line number.
+        Category category; ///< Category name.
+    };
+
+    /** @brief Call site key stored in the map. */
+    using CallSiteKey = CallSite<std::basic_string<Char>>;
+    /** @brief Call site key for the lookups without a copy of the category. */
+    using CallSiteView = CallSite<std::basic_string_view<Char>>;
+
+    /**
+     * @brief Call site key hash accepting both key types.
+     */
+    struct CallSiteHash {
+        /** @brief Enables the heterogeneous lookup. */
+        using is_transparent = void;
+
+        /**
+         * @brief Calculates hash of the call site key.
+         *
+         * @tparam Category Category string type.
+         * @param site Call site key.
+         * @return Hash value.
+         */
+        template<typename Category>
+        auto operator()(const CallSite<Category>& site) const noexcept -> std::size_t
+        {
+            constexpr auto Shift = 6U;
+            constexpr auto Magic = 0x9e3779b97f4a7c15ULL;
+            std::size_t seed = std::hash<const void*>{}(site.file);
+            for (const auto value :
+                 {std::hash<const void*>{}(site.function),
+                  std::hash<std::size_t>{}(site.line),
+                  std::hash<std::basic_string_view<Char>>{}(site.category)}) {
+                seed ^= value + Magic + (seed << Shift) + (seed >> 2U);
+            }
+            return seed;
+        }
+    };
+
+    /**
+     * @brief Call site key comparison accepting both key types.
+     */
+    struct CallSiteEqual {
+        /** @brief Enables the heterogeneous lookup. */
+        using is_transparent = void;
+
+        /**
+         * @brief Compares the call site keys.
+         *
+         * @tparam Lhs Category string type of the first key.
+         * @tparam Rhs Category string type of the second key.
+         * @param lhs First key.
+         * @param rhs Second key.
+         * @return \b true if the keys refer to the same call site.
+         */
+        template<typename Lhs, typename Rhs>
+        auto operator()(const CallSite<Lhs>& lhs, const CallSite<Rhs>& rhs) const noexcept
+            -> bool
+        {
+            return lhs.file == rhs.file && lhs.function == rhs.function && lhs.line == rhs.line
+                && std::basic_string_view<Char>(lhs.category)
+                == std::basic_string_view<Char>(rhs.category);
+        }
+    };
+
+    /**
+     * @brief Finds the call site ID, encoding the call site entry if it is new.
+     *
+     * Has to be called with the mutex locked.
+     *
+     * @param record The log record.
+     * @return Call site ID.
+     */
+    auto site_id(RecordType& record) -> std::uint32_t;
+
+    /**
+     * @brief Appends an integer to the block in little-endian byte order.
+     *
+     * @tparam T Integer type.
+     * @param block Destination block.
+     * @param value Value to append.
+     */
+    template<typename T>
+    static auto put(Block& block, T value) -> void;
+
+    /**
+     * @brief Appends length-prefixed string bytes to the block.
+     *
+     * @tparam Size Length prefix type.
+     * @tparam T Character type.
+     * @param block Destination block.
+     * @param str String to append.
+     */
+    template<typename Size, typename T>
+    static auto put_string(Block& block, std::basic_string_view<T> str) -> void;
+
+    std::unique_ptr<FILE, int (*)(FILE*)> m_fp = {nullptr, nullptr};
+    std::unordered_map<CallSiteKey, std::uint32_t, CallSiteHash, CallSiteEqual> m_sites;
+    Block m_block;
+    std::mutex m_mutex;
+};
+} // namespace SlimLog
+
+#ifdef SLIMLOG_HEADER_ONLY
+#include "slimlog/sinks/binary_file_sink-inl.h" // IWYU pragma: keep
+#endif
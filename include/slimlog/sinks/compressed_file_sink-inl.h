@@ -0,0 +1,216 @@
+/**
+ * @file compressed_file_sink-inl.h
+ * @brief Contains definition of CompressedFileSink class.
+ */
+
+#pragma once
+
+// IWYU pragma: private, include "slimlog/sinks/compressed_file_sink.h"
+
+#include "slimlog/sinks/compressed_file_sink.h" // IWYU pragma: associated
+
+#if defined(_WIN32) && defined(__STDC_WANT_SECURE_LIB__)
+// In addition to <cstdio> below for fopen_s() on Windows
+#include <stdio.h> // IWYU pragma: keep
+#endif
+
+#include <zlib.h>
+
+#include <cerrno>
+#include <iterator>
+#include <string>
+#include <system_error>
+#include <tuple>
+
+namespace SlimLog {
+
+template<typename String, typename Char, std::size_t BufferSize, typename Allocator>
+CompressedFileSink<String, Char, BufferSize, Allocator>::~CompressedFileSink()
+{
+    {
+        const std::lock_guard lock(m_mutex);
+        submit();
+        m_stop = true;
+    }
+    m_cond.notify_one();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+template<typename String, typename Char, std::size_t BufferSize, typename Allocator>
+auto CompressedFileSink<String, Char, BufferSize, Allocator>::open(std::string_view filename)
+    -> void
+{
+    // Frames are self-contained, so appending to an existing file is safe
+#if defined(_WIN32) && defined(__STDC_WANT_SECURE_LIB__)
+    FILE* fp;
+    std::ignore = fopen_s(&fp, std::string(filename).c_str(), "ab");
+    m_fp = {fp, std::fclose};
+#else
+    m_fp = {std::fopen(std::string(filename).c_str(), "ab"), std::fclose};
+#endif
+    if (!m_fp) {
+        throw std::system_error({errno, std::system_category()}, "Error opening log file");
+    }
+
+    m_current.reserve(BlockSize);
+    m_thread = std::thread(&CompressedFileSink::worker, this);
+}
+
+template<typename String, typename Char, std::size_t BufferSize, typename Allocator>
+auto CompressedFileSink<String, Char, BufferSize, Allocator>::message(RecordType& record) -> void
+{
+    FormatBufferType buffer;
+    this->format(buffer, record);
+    buffer.push_back('\n');
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    const auto* data = reinterpret_cast<const unsigned char*>(buffer.data());
+    const auto size = buffer.size() * sizeof(Char);
+
+    const Tracer::Scope trace(Stage::SinkWrite);
+    const std::lock_guard lock(m_mutex);
+    m_current.insert(m_current.end(), data, std::next(data, static_cast<std::ptrdiff_t>(size)));
+    ++m_current_records;
+    if (m_current.size() >= BlockSize) [[unlikely]] {
+        submit();
+    }
+}
+
+template<typename String, typename Char, std::size_t BufferSize, typename Allocator>
+auto CompressedFileSink<String, Char, BufferSize, Allocator>::flush() -> void
+{
+    this->counters().flushed();
+    std::unique_lock lock(m_mutex);
+    submit();
+    m_done.wait(lock, [this]() { return m_pending.empty() && m_in_progress == 0; });
+}
+
+template<typename String, typename Char, std::size_t BufferSize, typename Allocator>
+auto CompressedFileSink<String, Char, BufferSize, Allocator>::set_compression_level(int level)
+    -> void
+{
+    m_compression_level.store(level, std::memory_order_relaxed);
+}
+
+template<typename String, typename Char, std::size_t BufferSize, typename Allocator>
+auto CompressedFileSink<String, Char, BufferSize, Allocator>::stats() const -> CompressionStats
+{
+    return {
+        m_blocks.load(std::memory_order_relaxed),
+        m_dropped_blocks.load(std::memory_order_relaxed),
+        m_raw_bytes.load(std::memory_order_relaxed),
+        m_compressed_bytes.load(std::memory_order_relaxed),
+        std::chrono::nanoseconds(m_compress_time.load(std::memory_order_relaxed))};
+}
+
+template<typename String, typename Char, std::size_t BufferSize, typename Allocator>
+auto CompressedFileSink<String, Char, BufferSize, Allocator>::submit() -> void
+{
+    if (m_current.empty()) {
+        return;
+    }
+
+    if (m_pending.size() >= MaxPendingBlocks) [[unlikely]] {
+        // Compressor is too far behind: never block the caller, drop the block instead
+        m_dropped_blocks.fetch_add(1, std::memory_order_relaxed);
+        this->counters().dropped(m_current_records);
+        m_current.clear();
+        m_current_records = 0;
+        return;
+    }
+
+    m_pending.push_back(std::move(m_current));
+    m_current_records = 0;
+    if (m_free.empty()) {
+        m_current = Block();
+    } else {
+        m_current = std::move(m_free.back());
+        m_free.pop_back();
+    }
+    m_current.clear();
+    m_current.reserve(BlockSize);
+    m_cond.notify_one();
+}
+
+template<typename String, typename Char, std::size_t BufferSize, typename Allocator>
+auto CompressedFileSink<String, Char, BufferSize, Allocator>::worker() -> void
+{
+    Block output;
+    std::unique_lock lock(m_mutex);
+    for (;;) {
+        m_cond.wait(lock, [this]() { return m_stop || !m_pending.empty(); });
+        if (m_pending.empty()) {
+            break;
+        }
+
+        Block block = std::move(m_pending.front());
+        m_pending.pop_front();
+        ++m_in_progress;
+
+        lock.unlock();
+        write_frame(block, output);
+        lock.lock();
+
+        --m_in_progress;
+        if (m_free.size() < MaxPendingBlocks) {
+            m_free.push_back(std::move(block));
+        }
+        m_done.notify_all();
+    }
+}
+
+template<typename String, typename Char, std::size_t BufferSize, typename Allocator>
+auto CompressedFileSink<String, Char, BufferSize, Allocator>::write_frame(
+    const Block& block, Block& output) -> void
+{
+    const auto bound = ::compressBound(static_cast<uLong>(block.size()));
+    output.resize(FrameHeaderSize + bound);
+    auto* payload = std::next(output.data(), FrameHeaderSize);
+
+    const auto start = std::chrono::steady_clock::now();
+    uLongf compressed_size = bound;
+    const auto result = ::compress2(
+        payload,
+        &compressed_size,
+        block.data(),
+        static_cast<uLong>(block.size()),
+        m_compression_level.load(std::memory_order_relaxed));
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    if (result != Z_OK) [[unlikely]] {
+        m_dropped_blocks.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    const auto crc = ::crc32(::crc32(0L, Z_NULL, 0), payload, static_cast<uInt>(compressed_size));
+    const auto write_le = [&output](std::size_t offset, std::uint32_t value) {
+        constexpr unsigned ByteBits = 8;
+        constexpr unsigned ByteMask = 0xFF;
+        for (std::size_t i = 0; i < sizeof(value); ++i) {
+            output[offset + i] = static_cast<unsigned char>((value >> (i * ByteBits)) & ByteMask);
+        }
+    };
+    write_le(0, FrameMagic);
+    write_le(sizeof(std::uint32_t), static_cast<std::uint32_t>(block.size()));
+    write_le(2 * sizeof(std::uint32_t), static_cast<std::uint32_t>(compressed_size));
+    write_le(3 * sizeof(std::uint32_t), static_cast<std::uint32_t>(crc));
+
+    // Push every frame to the OS, so that a crash does not lose completed blocks
+    const auto frame_size = FrameHeaderSize + compressed_size;
+    if (std::fwrite(output.data(), frame_size, 1, m_fp.get()) != 1
+        || std::fflush(m_fp.get()) != 0) [[unlikely]] {
+        m_dropped_blocks.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    this->counters().written(frame_size);
+    m_blocks.fetch_add(1, std::memory_order_relaxed);
+    m_raw_bytes.fetch_add(block.size(), std::memory_order_relaxed);
+    m_compressed_bytes.fetch_add(frame_size, std::memory_order_relaxed);
+    m_compress_time.fetch_add(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+        std::memory_order_relaxed);
+}
+
+} // namespace SlimLog
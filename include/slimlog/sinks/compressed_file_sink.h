@@ -0,0 +1,219 @@
+/**
+ * @file compressed_file_sink.h
+ * @brief Contains declaration of CompressedFileSink class.
+ */
+
+#pragma once
+
+#ifndef SLIMLOG_ZLIB
+#error "CompressedFileSink requires zlib support (SLIMLOG_ZLIB)"
+#endif
+
+#include "slimlog/logger.h"
+#include "slimlog/sink.h"
+#include "slimlog/util/types.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace SlimLog {
+
+/**
+ * @brief Compression statistics of the CompressedFileSink.
+ */
+struct CompressionStats {
+    std::uint64_t blocks = {}; ///< Number of blocks written.
+    std::uint64_t dropped_blocks = {}; ///< Number of blocks dropped due to compressor backlog.
+    std::uint64_t raw_bytes = {}; ///< Total size of uncompressed data.
+    std::uint64_t compressed_bytes = {}; ///< Total size of compressed data.
+    std::chrono::nanoseconds compress_time = {}; ///< Time spent in the compressor.
+
+    /**
+     * @brief Calculates the compression ratio.
+     *
+     * @return Ratio of uncompressed to compressed size, or 0 if nothing was written.
+     */
+    [[nodiscard]] auto ratio() const -> double
+    {
+        return compressed_bytes == 0
+            ? 0.0
+            : static_cast<double>(raw_bytes) / static_cast<double>(compressed_bytes);
+    }
+
+    /**
+     * @brief Calculates the compressor throughput.
+     *
+     * @return Uncompressed bytes processed per second, or 0 if nothing was written.
+     */
+    [[nodiscard]] auto throughput() const -> double
+    {
+        const auto secs = std::chrono::duration<double>(compress_time).count();
+        return secs > 0 ? static_cast<double>(raw_bytes) / secs : 0.0;
+    }
+};
+
+/**
+ * @brief Output file-based sink with streaming compression.
+ *
+ * Formatted messages are collected into blocks which are handed over to
+ * a background thread for compression with zlib. Formatting threads never
+ * wait for the compressor: if too many blocks are pending, the filled block
+ * is dropped and accounted in the statistics.
+ *
+ * Every block is compressed independently and written as a separate frame:
+ *
+ * | Offset | Size | Description                            |
+ * |--------|------|----------------------------------------|
+ * | 0      | 4    | Magic number `SLZ1` (little-endian)    |
+ * | 4      | 4    | Uncompressed size (little-endian)      |
+ * | 8      | 4    | Compressed size (little-endian)        |
+ * | 12     | 4    | CRC-32 of compressed data              |
+ * | 16     | N    | zlib stream                            |
+ *
+ * Each frame is flushed to the OS after writing, so a crash loses at most
+ * the blocks which were not compressed yet, and a torn trailing frame
+ * is detected by its size and checksum.
+ *
+ * @tparam String String type for log messages.
+ * @tparam Char Character type for the string.
+ * @tparam BufferSize Size of the internal pre-allocated buffer.
+ * @tparam Allocator Allocator type for the internal buffer.
+ */
+template<
+    typename String,
+    typename Char = Util::Types::UnderlyingCharType<String>,
+    std::size_t BufferSize = DefaultBufferSize,
+    typename Allocator = std::allocator<Char>>
+class CompressedFileSink : public FormattableSink<String, Char, BufferSize, Allocator> {
+public:
+    using typename FormattableSink<String, Char, BufferSize, Allocator>::RecordType;
+    using typename FormattableSink<String, Char, BufferSize, Allocator>::FormatBufferType;
+
+    /** @brief Frame magic number (`SLZ1`). */
+    static constexpr std::uint32_t FrameMagic = 0x315A4C53;
+    /** @brief Frame header size in bytes. */
+    static constexpr std::size_t FrameHeaderSize = 16;
+    /** @brief Uncompressed block size in bytes. */
+    static constexpr std::size_t BlockSize = 64 * 1024;
+    /** @brief Maximum number of blocks waiting for compression. */
+    static constexpr std::size_t MaxPendingBlocks = 16;
+
+    /**
+     * @brief Constructs a new CompressedFileSink object.
+     *
+     * Opens the file and starts the compressor thread.
+     *
+     * @tparam Args Argument types for the pattern and log levels.
+     * @param filename Log file name.
+     * @param args Optional pattern and list of log levels.
+     */
+    template<typename... Args>
+    explicit CompressedFileSink(std::string_view filename, Args&&... args)
+        : FormattableSink<String, Char, BufferSize, Allocator>(std::forward<Args>(args)...)
+    {
+        open(filename);
+    }
+
+    CompressedFileSink(const CompressedFileSink&) = delete;
+    CompressedFileSink(CompressedFileSink&&) = delete;
+    auto operator=(const CompressedFileSink&) -> CompressedFileSink& = delete;
+    auto operator=(CompressedFileSink&&) -> CompressedFileSink& = delete;
+
+    /**
+     * @brief Compresses the remaining data and stops the compressor thread.
+     */
+    ~CompressedFileSink() override;
+
+    /**
+     * @brief Processes a log record.
+     *
+     * Formats the log record and appends it to the current block.
+     *
+     * @param record The log record to process.
+     */
+    auto message(RecordType& record) -> void override;
+
+    /**
+     * @brief Compresses the current block and waits until all blocks are written.
+     */
+    auto flush() -> void override;
+
+    /**
+     * @brief Sets the zlib compression level.
+     *
+     * @param level Compression level from 0 (no compression) to 9 (best compression).
+     */
+    auto set_compression_level(int level) -> void;
+
+    /**
+     * @brief Gets the compression statistics.
+     *
+     * @return Snapshot of the statistics.
+     */
+    [[nodiscard]] auto stats() const -> CompressionStats;
+
+protected:
+    /**
+     * @brief Opens a log file and starts the compressor thread.
+     *
+     * @param filename Log file name.
+     */
+    auto open(std::string_view filename) -> void;
+
+private:
+    using Block = std::vector<unsigned char>;
+
+    /**
+     * @brief Hands over the current block to the compressor thread.
+     *
+     * Has to be called with the mutex locked.
+     */
+    auto submit() -> void;
+
+    /**
+     * @brief Compressor thread routine.
+     */
+    auto worker() -> void;
+
+    /**
+     * @brief Compresses a block and writes it as a frame.
+     *
+     * @param block Uncompressed data.
+     * @param output Buffer for compressed data.
+     */
+    auto write_frame(const Block& block, Block& output) -> void;
+
+    std::unique_ptr<FILE, int (*)(FILE*)> m_fp = {nullptr, nullptr};
+    Block m_current;
+    std::size_t m_current_records = 0;
+    std::deque<Block> m_pending;
+    std::vector<Block> m_free;
+    std::size_t m_in_progress = 0;
+    bool m_stop = false;
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::condition_variable m_done;
+    std::atomic<int> m_compression_level = 1;
+    std::atomic<std::uint64_t> m_blocks = 0;
+    std::atomic<std::uint64_t> m_dropped_blocks = 0;
+    std::atomic<std::uint64_t> m_raw_bytes = 0;
+    std::atomic<std::uint64_t> m_compressed_bytes = 0;
+    std::atomic<std::int64_t> m_compress_time = 0;
+    std::thread m_thread;
+};
+} // namespace SlimLog
+
+#ifdef SLIMLOG_HEADER_ONLY
+#include "slimlog/sinks/compressed_file_sink-inl.h" // IWYU pragma: keep
+#endif
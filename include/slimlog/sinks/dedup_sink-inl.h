@@ -0,0 +1,100 @@
+/**
+ * @file dedup_sink-inl.h
+ * @brief Contains definition of DedupSink class.
+ */
+
+#pragma once
+
+// IWYU pragma: private, include "slimlog/sinks/dedup_sink.h"
+
+#include "slimlog/sinks/dedup_sink.h" // IWYU pragma: associated
+#include "slimlog/sampler.h"
+#include "slimlog/util/hash.h"
+
+#include <string_view>
+#include <utility>
+
+namespace SlimLog {
+
+template<typename String, typename Char>
+DedupSink<String, Char>::DedupSink(std::shared_ptr<SinkType> target, ClockType::duration window)
+    : m_target(std::move(target))
+    , m_window(window)
+{
+}
+
+template<typename String, typename Char>
+DedupSink<String, Char>::~DedupSink()
+{
+    const std::lock_guard lock(m_mutex);
+    report();
+}
+
+template<typename String, typename Char>
+auto DedupSink<String, Char>::message(RecordType& record) -> void
+{
+    const auto message = this->message_view(record);
+    auto hash = Util::Hash::hash64(message.data(), message.size() * sizeof(Char));
+    hash = Util::Hash::hash64(record.category.data(), record.category.size() * sizeof(Char), hash);
+    hash ^= static_cast<std::uint64_t>(record.level);
+    const auto now = ClockType::now();
+
+    const std::lock_guard lock(m_mutex);
+    expire(now);
+    if (hash == m_hash) {
+        ++m_repeats;
+        this->counters().dropped();
+        m_thread_id = record.thread_id;
+        m_time = record.time;
+        return;
+    }
+
+    report();
+    m_hash = hash;
+    m_window_start = now;
+    m_level = record.level;
+    m_location = record.location;
+    m_category = record.category;
+    m_thread_id = record.thread_id;
+    m_time = record.time;
+    m_target->deliver(record);
+}
+
+template<typename String, typename Char>
+auto DedupSink<String, Char>::flush() -> void
+{
+    this->counters().flushed();
+    {
+        const std::lock_guard lock(m_mutex);
+        report();
+        expire(ClockType::now());
+    }
+    m_target->flush();
+}
+
+template<typename String, typename Char>
+auto DedupSink<String, Char>::expire(ClockType::time_point now) -> void
+{
+    if (now - m_window_start < m_window) {
+        return;
+    }
+
+    report();
+    // Zero is the hash of no record, the next one starts a new window
+    m_hash = 0;
+}
+
+template<typename String, typename Char>
+auto DedupSink<String, Char>::report() -> void
+{
+    if (m_repeats == 0) {
+        return;
+    }
+
+    const RecordType origin = {
+        m_level, m_location, std::basic_string_view<Char>{m_category}, m_thread_id, m_time};
+    forward_summary(*m_target, origin, RepeatedFormat, m_repeats);
+    m_repeats = 0;
+}
+
+} // namespace SlimLog
@@ -0,0 +1,131 @@
+/**
+ * @file dedup_sink.h
+ * @brief Contains declaration of DedupSink class.
+ */
+
+#pragma once
+
+#include "slimlog/level.h"
+#include "slimlog/record.h"
+#include "slimlog/sink.h"
+#include "slimlog/util/types.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace SlimLog {
+
+/**
+ * @brief Duplicate message collapsing sink wrapper.
+ *
+ * Passes records to the target sink, suppressing the records which repeat the previous
+ * one (the same level, category and message) within a time window. When a different
+ * record arrives, a record arrives after the window expired, the sink is flushed or destroyed,
+ * the number of suppressed records is reported with a "Last message repeated N times" record,
+ * similar to syslog. There is no timer: a window expiry is noticed by the next message()
+ * or flush() call.
+ * Records are compared by a 64-bit hash of their contents.
+ *
+ * Usage example:
+ * ```cpp
+ * Log::Logger log("main");
+ * auto file = std::make_shared<Log::FileSink<std::string_view>>("app.log");
+ * log.add_sink<Log::DedupSink>(file, std::chrono::seconds(10));
+ * ```
+ *
+ * @tparam String String type for log messages.
+ * @tparam Char Character type for the string.
+ */
+template<typename String, typename Char = Util::Types::UnderlyingCharType<String>>
+class DedupSink : public Sink<String, Char> {
+public:
+    using typename Sink<String, Char>::RecordType;
+    /** @brief Target sink type. */
+    using SinkType = Sink<String, Char>;
+    /** @brief Clock type used for the window. */
+    using ClockType = std::chrono::steady_clock;
+
+    /** @brief Default duplicate suppression window. */
+    static constexpr std::chrono::seconds DefaultWindow{30};
+
+    /**
+     * @brief Constructs a new DedupSink object.
+     *
+     * @param target Sink receiving the records.
+     * @param window Time window in which repeated records are suppressed.
+     */
+    explicit DedupSink(
+        std::shared_ptr<SinkType> target, ClockType::duration window = DefaultWindow);
+
+    DedupSink(const DedupSink&) = delete;
+    DedupSink(DedupSink&&) = delete;
+    auto operator=(const DedupSink&) -> DedupSink& = delete;
+    auto operator=(DedupSink&&) -> DedupSink& = delete;
+
+    /**
+     * @brief Reports pending repeats.
+     */
+    ~DedupSink() override;
+
+    /**
+     * @brief Processes a log record.
+     *
+     * Reports pending repeats of the expired window first, then passes the log record
+     * to the target sink unless it repeats the previous one.
+     *
+     * @param record The log record to process.
+     */
+    auto message(RecordType& record) -> void override;
+
+    /**
+     * @brief Reports pending repeats and flushes the target sink.
+     *
+     * Starts a new window if the current one has expired, so that the next record
+     * passes even if it repeats the previous one.
+     */
+    auto flush() -> void override;
+
+private:
+    /** @brief Format string of the repeat summary. */
+    static constexpr std::array<Char, 31> RepeatedFormat{
+        'L', 'a', 's', 't', ' ', 'm', 'e', 's', 's', 'a', 'g', 'e', ' ', 'r', 'e', 'p',
+        'e', 'a', 't', 'e', 'd', ' ', '{', '}', ' ', 't', 'i', 'm', 'e', 's', '\0'};
+
+    /**
+     * @brief Emits the repeat summary if some records have been suppressed.
+     *
+     * Has to be called with the mutex locked.
+     */
+    auto report() -> void;
+
+    /**
+     * @brief Reports pending repeats and forgets the previous record if the window expired.
+     *
+     * Has to be called with the mutex locked.
+     *
+     * @param now Current time.
+     */
+    auto expire(ClockType::time_point now) -> void;
+
+    std::shared_ptr<SinkType> m_target;
+    ClockType::duration m_window;
+    ClockType::time_point m_window_start;
+    std::uint64_t m_hash = 0;
+    std::uint64_t m_repeats = 0;
+    Level m_level = {};
+    RecordLocation m_location;
+    std::basic_string<Char> m_category;
+    std::size_t m_thread_id = {};
+    RecordTime m_time = {};
+    std::mutex m_mutex;
+};
+} // namespace SlimLog
+
+#ifdef SLIMLOG_HEADER_ONLY
+#include "slimlog/sinks/dedup_sink-inl.h" // IWYU pragma: keep
+#endif
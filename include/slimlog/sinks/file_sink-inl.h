@@ -41,14 +41,18 @@ auto FileSink<String, Char, BufferSize, Allocator>::message(RecordType& record)
     FormatBufferType buffer;
     this->format(buffer, record);
     buffer.push_back('\n');
+
+    const Tracer::Scope trace(Stage::SinkWrite);
     if (std::fwrite(buffer.data(), buffer.size(), 1, m_fp.get()) != 1) {
         throw std::system_error({errno, std::system_category()}, "Failed writing to log file");
     }
+    this->counters().written(buffer.size());
 }
 
 template<typename String, typename Char, std::size_t BufferSize, typename Allocator>
 auto FileSink<String, Char, BufferSize, Allocator>::flush() -> void
 {
+    this->counters().flushed();
     if (std::fflush(m_fp.get()) != 0) {
         throw std::system_error({errno, std::system_category()}, "Failed flush to log file");
     }
@@ -19,6 +19,7 @@ auto NullSink<String, Char>::message(RecordType& /*unused*/) -> void
 template<typename String, typename Char>
 auto NullSink<String, Char>::flush() -> void
 {
+    this->counters().flushed();
 }
 
 } // namespace SlimLog
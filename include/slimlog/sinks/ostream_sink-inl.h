@@ -17,12 +17,16 @@ auto OStreamSink<String, Char, BufferSize, Allocator>::message(RecordType& recor
     FormatBufferType buffer;
     this->format(buffer, record);
     buffer.push_back('\n');
+
+    const Tracer::Scope trace(Stage::SinkWrite);
     m_ostream.write(buffer.begin(), buffer.size());
+    this->counters().written(buffer.size() * sizeof(Char));
 }
 
 template<typename String, typename Char, std::size_t BufferSize, typename Allocator>
 auto OStreamSink<String, Char, BufferSize, Allocator>::flush() -> void
 {
+    this->counters().flushed();
     m_ostream.flush();
 }
 
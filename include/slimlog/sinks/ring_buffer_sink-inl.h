@@ -0,0 +1,222 @@
+/**
+ * @file ring_buffer_sink-inl.h
+ * @brief Contains definition of RingBufferSink class.
+ */
+
+#pragma once
+
+// IWYU pragma: private, include "slimlog/sinks/ring_buffer_sink.h"
+
+#include "slimlog/sinks/ring_buffer_sink.h" // IWYU pragma: associated
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace SlimLog {
+
+template<typename String, typename Char>
+RingBufferSink<String, Char>::RingBufferSink(
+    std::shared_ptr<SinkType> target,
+    std::size_t capacity,
+    Level trigger,
+    std::size_t max_message_size)
+    : m_target(std::move(target))
+    , m_capacity(std::max<std::size_t>(capacity, 1))
+    , m_slot_size(max_message_size)
+    // Category and message start at word boundaries, so one more word may be needed
+    , m_slot_words(((m_slot_size + CharsPerWord - 1) / CharsPerWord) + 1)
+    , m_slots(std::make_unique<Slot[]>(m_capacity)) // NOLINT(*-avoid-c-arrays)
+    // NOLINTNEXTLINE(*-avoid-c-arrays)
+    , m_data(std::make_unique<std::atomic<Word>[]>(m_capacity * m_slot_words))
+    , m_trigger(trigger)
+{
+}
+
+template<typename String, typename Char>
+auto RingBufferSink<String, Char>::message(RecordType& record) -> void
+{
+    if (record.level <= m_trigger.load(std::memory_order_relaxed)) [[unlikely]] {
+        // The record the ring gives context for is passed on intact, after the context
+        const std::lock_guard lock(m_dump_mutex);
+        replay();
+        m_target->deliver(record);
+        return;
+    }
+
+    const auto message = this->message_view(record);
+    const auto index = m_head.fetch_add(1, std::memory_order_relaxed);
+    const auto position = index % m_capacity;
+    auto& slot = m_slots[position];
+
+    // Claim the slot, unless another writer is still busy with it or has already
+    // stored a newer record there after lapping the ring
+    const auto claim = (index * 2) + 1;
+    auto sequence = slot.sequence.load(std::memory_order_relaxed);
+    do {
+        if ((sequence & 1U) != 0 || sequence >= claim) [[unlikely]] {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            this->counters().dropped();
+            return;
+        }
+    } while (!slot.sequence.compare_exchange_weak(
+        sequence, claim, std::memory_order_acquire, std::memory_order_relaxed));
+
+    // Keeps the stores below after the claim for dump() seeing any of them
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const auto category_size = std::min(record.category.size(), m_slot_size);
+    const auto message_size = std::min(message.size(), m_slot_size - category_size);
+    auto* words = std::next(m_data.get(), static_cast<std::ptrdiff_t>(position * m_slot_words));
+    const auto category_words = store(words, record.category.data(), category_size);
+    store(
+        std::next(words, static_cast<std::ptrdiff_t>(category_words)),
+        message.data(),
+        message_size);
+
+    constexpr auto Relaxed = std::memory_order_relaxed;
+    slot.level.store(record.level, Relaxed);
+    slot.file.store(record.location.filename.data(), Relaxed);
+    slot.file_size.store(record.location.filename.size(), Relaxed);
+    slot.function.store(record.location.function.data(), Relaxed);
+    slot.function_size.store(record.location.function.size(), Relaxed);
+    slot.line.store(record.location.line, Relaxed);
+    slot.thread_id.store(record.thread_id, Relaxed);
+    slot.seconds.store(record.time.local.time_since_epoch().count(), Relaxed);
+    slot.nsec.store(record.time.nsec, Relaxed);
+    slot.category_size.store(category_size, Relaxed);
+    slot.message_size.store(message_size, Relaxed);
+    slot.sequence.store(claim + 1, std::memory_order_release);
+}
+
+template<typename String, typename Char>
+auto RingBufferSink<String, Char>::flush() -> void
+{
+    this->counters().flushed();
+    m_target->flush();
+}
+
+template<typename String, typename Char>
+auto RingBufferSink<String, Char>::dump() -> void
+{
+    const std::lock_guard lock(m_dump_mutex);
+    replay();
+}
+
+template<typename String, typename Char>
+auto RingBufferSink<String, Char>::replay() -> void
+{
+    const auto head = m_head.load(std::memory_order_acquire);
+    const auto first = head > m_capacity ? head - m_capacity : 0;
+    std::basic_string<Char> buffer(m_slot_words * CharsPerWord, Char{});
+
+    // Records still being written at the previous dump come first, unless overwritten since
+    std::vector<std::uint64_t> pending;
+    for (const auto index : m_pending) {
+        if (index >= first && !forward(index, buffer)) {
+            pending.push_back(index);
+        }
+    }
+    for (auto index = std::max(m_tail, first); index < head; ++index) {
+        if (!forward(index, buffer)) {
+            pending.push_back(index);
+        }
+    }
+
+    m_pending = std::move(pending);
+    m_tail = head;
+}
+
+template<typename String, typename Char>
+auto RingBufferSink<String, Char>::forward(std::uint64_t index, std::basic_string<Char>& buffer)
+    -> bool
+{
+    const auto& slot = m_slots[index % m_capacity];
+    const auto expected = (index * 2) + 2;
+    const auto sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence != expected) {
+        // Overwritten by a newer record or still being written
+        return sequence > expected;
+    }
+
+    constexpr auto Relaxed = std::memory_order_relaxed;
+    RecordType record;
+    record.level = slot.level.load(Relaxed);
+    record.location = {
+        RecordStringView(slot.file.load(Relaxed), slot.file_size.load(Relaxed)),
+        RecordStringView(slot.function.load(Relaxed), slot.function_size.load(Relaxed)),
+        slot.line.load(Relaxed)};
+    record.thread_id = slot.thread_id.load(Relaxed);
+    record.time = {
+        std::chrono::sys_seconds(std::chrono::seconds(slot.seconds.load(Relaxed))),
+        slot.nsec.load(Relaxed)};
+    const auto category_size = std::min(slot.category_size.load(Relaxed), m_slot_size);
+    const auto message_size
+        = std::min(slot.message_size.load(Relaxed), m_slot_size - category_size);
+    const auto* words
+        = std::next(m_data.get(), static_cast<std::ptrdiff_t>((index % m_capacity) * m_slot_words));
+    const auto category_words = (category_size + CharsPerWord - 1) / CharsPerWord;
+    load(words, buffer.data(), category_size);
+    load(std::next(words, static_cast<std::ptrdiff_t>(category_words)),
+         std::next(buffer.data(), static_cast<std::ptrdiff_t>(category_words * CharsPerWord)),
+         message_size);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != expected) {
+        // Overwritten while reading
+        return true;
+    }
+
+    record.category = RecordStringView(buffer.data(), category_size);
+    record.message = RecordStringView(
+        std::next(buffer.data(), static_cast<std::ptrdiff_t>(category_words * CharsPerWord)),
+        message_size);
+    m_target->deliver(record);
+    return true;
+}
+
+template<typename String, typename Char>
+auto RingBufferSink<String, Char>::store(
+    std::atomic<Word>* words, const Char* data, std::size_t size) noexcept -> std::size_t
+{
+    std::size_t count = 0;
+    for (std::size_t offset = 0; offset < size; offset += CharsPerWord, ++count) {
+        Word word = 0;
+        std::memcpy(
+            &word,
+            std::next(data, static_cast<std::ptrdiff_t>(offset)),
+            std::min(CharsPerWord, size - offset) * sizeof(Char));
+        std::next(words, static_cast<std::ptrdiff_t>(count))
+            ->store(word, std::memory_order_relaxed);
+    }
+    return count;
+}
+
+template<typename String, typename Char>
+auto RingBufferSink<String, Char>::load(
+    const std::atomic<Word>* words, Char* data, std::size_t size) noexcept -> void
+{
+    for (std::size_t offset = 0; offset < size; offset += CharsPerWord) {
+        const auto word = std::next(words, static_cast<std::ptrdiff_t>(offset / CharsPerWord))
+                              ->load(std::memory_order_relaxed);
+        std::memcpy(std::next(data, static_cast<std::ptrdiff_t>(offset)), &word, sizeof(Word));
+    }
+}
+
+template<typename String, typename Char>
+auto RingBufferSink<String, Char>::set_trigger_level(Level trigger) -> void
+{
+    m_trigger.store(trigger, std::memory_order_relaxed);
+}
+
+template<typename String, typename Char>
+auto RingBufferSink<String, Char>::dropped() const -> std::uint64_t
+{
+    return m_dropped.load(std::memory_order_relaxed);
+}
+
+} // namespace SlimLog
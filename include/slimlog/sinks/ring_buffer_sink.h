@@ -0,0 +1,198 @@
+/**
+ * @file ring_buffer_sink.h
+ * @brief Contains declaration of RingBufferSink class.
+ */
+
+#pragma once
+
+#include "slimlog/level.h"
+#include "slimlog/sink.h"
+#include "slimlog/util/types.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace SlimLog {
+
+/**
+ * @brief In-memory flight recorder sink.
+ *
+ * Keeps the most recent log records in a preallocated ring without formatting them.
+ * Records are forwarded to the target sink only when a record at or above the trigger
+ * level arrives, or when dump() is called explicitly. The triggering record itself is
+ * not stored: it is forwarded intact right after the records replayed from the ring.
+ * Storing a record is lock-free and costs a copy of the category and message into
+ * a fixed-size slot, longer records are cut to `max_message_size` characters.
+ *
+ * The ring is bounded both by the number of records and by size: slots are preallocated,
+ * so the memory is fixed at `capacity * max_message_size` characters. To keep the last
+ * N bytes rather than the last N records, pass `capacity = N / max_message_size`.
+ *
+ * Usage example:
+ * ```cpp
+ * Log::Logger log("main", Log::Level::Trace);
+ * auto console = std::make_shared<Log::OStreamSink<std::string_view>>(std::cerr);
+ * log.add_sink<Log::RingBufferSink>(console, 1024, Log::Level::Error);
+ * ```
+ *
+ * @tparam String String type for log messages.
+ * @tparam Char Character type for the string.
+ */
+template<typename String, typename Char = Util::Types::UnderlyingCharType<String>>
+class RingBufferSink : public Sink<String, Char> {
+public:
+    using typename Sink<String, Char>::RecordType;
+    /** @brief Target sink type. */
+    using SinkType = Sink<String, Char>;
+
+    /** @brief Default maximum size of category and message stored per record. */
+    static constexpr std::size_t DefaultMessageSize = 256;
+
+    /**
+     * @brief Constructs a new RingBufferSink object.
+     *
+     * @param target Sink receiving the dumped records.
+     * @param capacity Maximum number of records kept in the ring.
+     * @param trigger Records at or above this level trigger a dump.
+     * @param max_message_size Maximum number of characters stored per record,
+     *                         longer messages are truncated.
+     */
+    RingBufferSink(
+        std::shared_ptr<SinkType> target,
+        std::size_t capacity,
+        Level trigger = Level::Error,
+        std::size_t max_message_size = DefaultMessageSize);
+
+    RingBufferSink(const RingBufferSink&) = delete;
+    RingBufferSink(RingBufferSink&&) = delete;
+    auto operator=(const RingBufferSink&) -> RingBufferSink& = delete;
+    auto operator=(RingBufferSink&&) -> RingBufferSink& = delete;
+    ~RingBufferSink() override = default;
+
+    /**
+     * @brief Processes a log record.
+     *
+     * Stores the log record in the ring. If the trigger level is reached, dumps the ring
+     * and forwards the record to the target sink instead.
+     *
+     * @param record The log record to process.
+     */
+    auto message(RecordType& record) -> void override;
+
+    /**
+     * @brief Flushes the target sink.
+     */
+    auto flush() -> void override;
+
+    /**
+     * @brief Forwards all records stored since the previous dump to the target sink.
+     */
+    auto dump() -> void;
+
+    /**
+     * @brief Sets the level triggering a dump.
+     *
+     * @param trigger Records at or above this level trigger a dump.
+     */
+    auto set_trigger_level(Level trigger) -> void;
+
+    /**
+     * @brief Gets the number of records dropped due to contention on a ring slot.
+     *
+     * @return Number of dropped records.
+     */
+    [[nodiscard]] auto dropped() const -> std::uint64_t;
+
+private:
+    /** @brief Word of the slot data, accessed atomically. */
+    using Word = std::uint64_t;
+
+    /** @brief Number of characters per data word. */
+    static constexpr std::size_t CharsPerWord = sizeof(Word) / sizeof(Char);
+
+    /**
+     * @brief Ring slot holding the record fields.
+     *
+     * The sequence number works as a seqlock: it is odd while the slot is being written
+     * and equals `2 * index + 2` once the record with the given ring index is complete.
+     * All fields are relaxed atomics, as a writer which has lapped the ring may overwrite
+     * them while dump() reads them; dump() discards such reads by the sequence re-check.
+     */
+    struct Slot {
+        std::atomic<std::uint64_t> sequence = 0; ///< Sequence number.
+        std::atomic<Level> level = {}; ///< Log level.
+        std::atomic<const char*> file = {}; ///< File name.
+        std::atomic<std::size_t> file_size = {}; ///< File name size.
+        std::atomic<const char*> function = {}; ///< Function name.
+        std::atomic<std::size_t> function_size = {}; ///< Function name size.
+        std::atomic<std::size_t> line = {}; ///< Line number.
+        std::atomic<std::size_t> thread_id = {}; ///< Thread ID.
+        std::atomic<std::int64_t> seconds = {}; ///< Record time (seconds part).
+        std::atomic<std::size_t> nsec = {}; ///< Record time (nanoseconds part).
+        std::atomic<std::size_t> category_size = {}; ///< Number of category characters.
+        std::atomic<std::size_t> message_size = {}; ///< Number of message characters.
+    };
+
+    /**
+     * @brief Stores the characters into the slot data words.
+     *
+     * @param words Destination words.
+     * @param data Characters to store.
+     * @param size Number of characters.
+     * @return Number of words written.
+     */
+    static auto store(std::atomic<Word>* words, const Char* data, std::size_t size) noexcept
+        -> std::size_t;
+
+    /**
+     * @brief Loads the slot data words into the characters.
+     *
+     * @param words Source words.
+     * @param data Destination with room for the whole words.
+     * @param size Number of characters to load.
+     */
+    static auto load(const std::atomic<Word>* words, Char* data, std::size_t size) noexcept
+        -> void;
+
+    /**
+     * @brief Forwards the record with the given ring index to the target sink.
+     *
+     * Has to be called with the dump mutex locked.
+     *
+     * @param index Ring index.
+     * @param buffer Buffer for the category and message.
+     * @return \b true if the record has been forwarded or overwritten.
+     * @return \b false if the record is still being written.
+     */
+    auto forward(std::uint64_t index, std::basic_string<Char>& buffer) -> bool;
+
+    /**
+     * @brief Forwards the records stored since the previous dump to the target sink.
+     *
+     * Has to be called with the dump mutex locked.
+     */
+    auto replay() -> void;
+
+    std::shared_ptr<SinkType> m_target;
+    std::size_t m_capacity;
+    std::size_t m_slot_size;
+    std::size_t m_slot_words;
+    std::unique_ptr<Slot[]> m_slots; // NOLINT(*-avoid-c-arrays)
+    std::unique_ptr<std::atomic<Word>[]> m_data; // NOLINT(*-avoid-c-arrays)
+    std::atomic<std::uint64_t> m_head = 0;
+    std::atomic<Level> m_trigger;
+    std::atomic<std::uint64_t> m_dropped = 0;
+    std::uint64_t m_tail = 0;
+    std::vector<std::uint64_t> m_pending;
+    std::mutex m_dump_mutex;
+};
+} // namespace SlimLog
+
+#ifdef SLIMLOG_HEADER_ONLY
+#include "slimlog/sinks/ring_buffer_sink-inl.h" // IWYU pragma: keep
+#endif
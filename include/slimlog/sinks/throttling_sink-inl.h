@@ -0,0 +1,71 @@
+/**
+ * @file throttling_sink-inl.h
+ * @brief Contains definition of ThrottlingSink class.
+ */
+
+#pragma once
+
+// IWYU pragma: private, include "slimlog/sinks/throttling_sink.h"
+
+#include "slimlog/sinks/throttling_sink.h" // IWYU pragma: associated
+
+#include <functional>
+#include <utility>
+
+namespace SlimLog {
+
+template<typename String, typename Char>
+ThrottlingSink<String, Char>::ThrottlingSink(
+    std::shared_ptr<SinkType> target, double per_second, ThrottlingUnit unit)
+    : m_target(std::move(target))
+    , m_per_second(per_second)
+    , m_unit(unit)
+{
+}
+
+template<typename String, typename Char>
+auto ThrottlingSink<String, Char>::message(RecordType& record) -> void
+{
+    const auto cost = m_unit == ThrottlingUnit::Bytes
+        ? this->message_view(record).size() * sizeof(Char)
+        : std::size_t{1};
+    const auto suppressed = bucket(record.category).sampler.rate_limited(m_per_second, cost);
+    if (!suppressed) {
+        this->counters().dropped();
+        return;
+    }
+
+    m_target->deliver(record);
+    if (*suppressed > 0) [[unlikely]] {
+        forward_summary(*m_target, record, SuppressedFormat<Char>, *suppressed);
+    }
+}
+
+template<typename String, typename Char>
+auto ThrottlingSink<String, Char>::flush() -> void
+{
+    this->counters().flushed();
+    m_target->flush();
+}
+
+template<typename String, typename Char>
+auto ThrottlingSink<String, Char>::bucket(std::basic_string_view<Char> category) -> Bucket&
+{
+    // Zero key marks an unused bucket
+    const auto hash = std::hash<std::basic_string_view<Char>>{}(category) | 1U;
+    for (std::size_t i = 0; i < MaxCategories; ++i) {
+        auto& bucket = m_buckets[(hash + i) % MaxCategories];
+        auto key = bucket.key.load(std::memory_order_acquire);
+        if (key == 0) {
+            if (bucket.key.compare_exchange_strong(key, hash, std::memory_order_acq_rel)) {
+                return bucket;
+            }
+        }
+        if (key == hash) {
+            return bucket;
+        }
+    }
+    return m_overflow;
+}
+
+} // namespace SlimLog
@@ -0,0 +1,111 @@
+/**
+ * @file throttling_sink.h
+ * @brief Contains declaration of ThrottlingSink class.
+ */
+
+#pragma once
+
+#include "slimlog/sampler.h"
+#include "slimlog/sink.h"
+#include "slimlog/util/types.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+namespace SlimLog {
+
+/**
+ * @brief Units of the throttling budget.
+ */
+enum class ThrottlingUnit : std::uint8_t {
+    Records, ///< Number of records per second.
+    Bytes ///< Number of message bytes per second.
+};
+
+/**
+ * @brief Throttling sink wrapper.
+ *
+ * Passes records to the target sink within a per-category budget of records or message
+ * bytes per second (token bucket with one second burst). Excess records are dropped and
+ * counted, the next record which fits the budget is followed by a summary with the number
+ * of suppressed messages. The budgets are kept in a fixed-size lock-free table indexed by
+ * the category hash, categories which do not fit into the table share a common budget.
+ *
+ * Usage example:
+ * ```cpp
+ * Log::Logger log("main");
+ * auto file = std::make_shared<Log::FileSink<std::string_view>>("app.log");
+ * log.add_sink<Log::ThrottlingSink>(file, 1024 * 1024, Log::ThrottlingUnit::Bytes);
+ * ```
+ *
+ * @tparam String String type for log messages.
+ * @tparam Char Character type for the string.
+ */
+template<typename String, typename Char = Util::Types::UnderlyingCharType<String>>
+class ThrottlingSink : public Sink<String, Char> {
+public:
+    using typename Sink<String, Char>::RecordType;
+    /** @brief Target sink type. */
+    using SinkType = Sink<String, Char>;
+
+    /** @brief Maximum number of categories with a separate budget. */
+    static constexpr std::size_t MaxCategories = 64;
+
+    /**
+     * @brief Constructs a new ThrottlingSink object.
+     *
+     * @param target Sink receiving the records which fit the budget.
+     * @param per_second Budget per category and second.
+     * @param unit Units of the budget.
+     */
+    ThrottlingSink(
+        std::shared_ptr<SinkType> target,
+        double per_second,
+        ThrottlingUnit unit = ThrottlingUnit::Records);
+
+    /**
+     * @brief Processes a log record.
+     *
+     * Passes the log record to the target sink if it fits the category budget.
+     *
+     * @param record The log record to process.
+     */
+    auto message(RecordType& record) -> void override;
+
+    /**
+     * @brief Flushes the target sink.
+     */
+    auto flush() -> void override;
+
+private:
+    /**
+     * @brief Budget of the particular category.
+     */
+    struct Bucket {
+        std::atomic<std::size_t> key = 0; ///< Category hash (zero if unused).
+        Sampler sampler; ///< Rate limiter.
+    };
+
+    /**
+     * @brief Finds or allocates the budget of the category.
+     *
+     * @param category Log category.
+     * @return Reference to the budget.
+     */
+    auto bucket(std::basic_string_view<Char> category) -> Bucket&;
+
+    std::shared_ptr<SinkType> m_target;
+    double m_per_second;
+    ThrottlingUnit m_unit;
+    std::array<Bucket, MaxCategories> m_buckets;
+    Bucket m_overflow;
+};
+} // namespace SlimLog
+
+#ifdef SLIMLOG_HEADER_ONLY
+#include "slimlog/sinks/throttling_sink-inl.h" // IWYU pragma: keep
+#endif
@@ -0,0 +1,168 @@
+/**
+ * @file time_rotating_file_sink-inl.h
+ * @brief Contains definition of TimeRotatingFileSink class.
+ */
+
+#pragma once
+
+// IWYU pragma: private, include "slimlog/sinks/time_rotating_file_sink.h"
+
+#include "slimlog/sinks/time_rotating_file_sink.h" // IWYU pragma: associated
+
+#if defined(_WIN32) && defined(__STDC_WANT_SECURE_LIB__)
+// In addition to <cstdio> below for fopen_s() on Windows
+#include <stdio.h> // IWYU pragma: keep
+#endif
+
+#include <cerrno>
+#include <system_error>
+#include <tuple>
+
+namespace SlimLog {
+
+template<typename String, typename Char, std::size_t BufferSize, typename Allocator>
+auto TimeRotatingFileSink<String, Char, BufferSize, Allocator>::message(RecordType& record)
+    -> void
+{
+    FormatBufferType buffer;
+    this->format(buffer, record);
+    buffer.push_back('\n');
+
+    const Tracer::Scope trace(Stage::SinkWrite);
+    const std::lock_guard lock(m_mutex);
+    if (record.time.local >= m_precreate_time || record.time.local < m_period_start)
+        [[unlikely]] {
+        rotate(record.time.local);
+    }
+    if (std::fwrite(buffer.data(), buffer.size(), 1, m_fp.get()) != 1) {
+        throw std::system_error({errno, std::system_category()}, "Failed writing to log file");
+    }
+    this->counters().written(buffer.size());
+}
+
+template<typename String, typename Char, std::size_t BufferSize, typename Allocator>
+auto TimeRotatingFileSink<String, Char, BufferSize, Allocator>::flush() -> void
+{
+    this->counters().flushed();
+    const std::lock_guard lock(m_mutex);
+    // Nothing to flush before the first record, and fflush(nullptr) would flush all streams
+    if (m_fp && std::fflush(m_fp.get()) != 0) {
+        throw std::system_error({errno, std::system_category()}, "Failed flush to log file");
+    }
+}
+
+template<typename String, typename Char, std::size_t BufferSize, typename Allocator>
+auto TimeRotatingFileSink<String, Char, BufferSize, Allocator>::file_name(
+    std::chrono::sys_seconds time) const -> std::string
+{
+    const auto days = std::chrono::floor<std::chrono::days>(time);
+    const std::chrono::year_month_day date{days};
+    const auto hours = std::chrono::duration_cast<std::chrono::hours>(time - days).count();
+
+    const auto append_number = [](std::string& str, auto value, std::size_t width) {
+        const auto number = std::to_string(value);
+        if (number.size() < width) {
+            str.append(width - number.size(), '0');
+        }
+        str.append(number);
+    };
+
+    constexpr std::size_t YearWidth = 4;
+    constexpr std::size_t FieldWidth = 2;
+
+    std::string result = m_basename;
+    result.push_back('_');
+    append_number(result, static_cast<int>(date.year()), YearWidth);
+    result.push_back('-');
+    append_number(result, static_cast<unsigned>(date.month()), FieldWidth);
+    result.push_back('-');
+    append_number(result, static_cast<unsigned>(date.day()), FieldWidth);
+    if (m_period == RotationPeriod::Hourly) {
+        result.push_back('_');
+        append_number(result, hours, FieldWidth);
+    }
+    result.append(m_extension);
+    return result;
+}
+
+template<typename String, typename Char, std::size_t BufferSize, typename Allocator>
+auto TimeRotatingFileSink<String, Char, BufferSize, Allocator>::period_start(
+    std::chrono::sys_seconds time) const -> std::chrono::sys_seconds
+{
+    if (m_period == RotationPeriod::Hourly) {
+        return std::chrono::floor<std::chrono::hours>(time);
+    }
+    return std::chrono::floor<std::chrono::days>(time);
+}
+
+template<typename String, typename Char, std::size_t BufferSize, typename Allocator>
+auto TimeRotatingFileSink<String, Char, BufferSize, Allocator>::next_rotation(
+    std::chrono::sys_seconds time) const -> std::chrono::sys_seconds
+{
+    if (m_period == RotationPeriod::Hourly) {
+        return period_start(time) + std::chrono::hours(1);
+    }
+    return period_start(time) + std::chrono::days(1);
+}
+
+template<typename String, typename Char, std::size_t BufferSize, typename Allocator>
+auto TimeRotatingFileSink<String, Char, BufferSize, Allocator>::init(std::string_view filename)
+    -> void
+{
+    // Split extension only from the last path component
+    const auto ext_pos = filename.rfind('.');
+    const auto sep_pos = filename.find_last_of("/\\");
+    if (ext_pos != std::string_view::npos && ext_pos > 0
+        && (sep_pos == std::string_view::npos || ext_pos > sep_pos + 1)) {
+        m_basename = filename.substr(0, ext_pos);
+        m_extension = filename.substr(ext_pos);
+    } else {
+        m_basename = filename;
+    }
+}
+
+template<typename String, typename Char, std::size_t BufferSize, typename Allocator>
+auto TimeRotatingFileSink<String, Char, BufferSize, Allocator>::open(
+    std::chrono::sys_seconds time) const -> FilePtr
+{
+    const auto filename = file_name(time);
+#if defined(_WIN32) && defined(__STDC_WANT_SECURE_LIB__)
+    FILE* fp;
+    std::ignore = fopen_s(&fp, filename.c_str(), "a");
+    FilePtr result = {fp, std::fclose};
+#else
+    FilePtr result = {std::fopen(filename.c_str(), "a"), std::fclose};
+#endif
+    if (!result) {
+        throw std::system_error({errno, std::system_category()}, "Error opening log file");
+    }
+    return result;
+}
+
+template<typename String, typename Char, std::size_t BufferSize, typename Allocator>
+auto TimeRotatingFileSink<String, Char, BufferSize, Allocator>::rotate(
+    std::chrono::sys_seconds time) -> void
+{
+    if (time >= m_period_start && time < m_next_rotation) {
+        // Boundary is close: create the next file in advance
+        if (!m_next_fp) {
+            m_next_fp = open(m_next_rotation);
+        }
+        return;
+    }
+
+    if (m_next_fp && time >= m_next_rotation && time < next_rotation(m_next_rotation)) {
+        // The pre-created file belongs to the current period
+        m_fp = std::move(m_next_fp);
+    } else {
+        // The first record, no file was pre-created, logging was idle for the whole period
+        // or the clock went back
+        m_next_fp.reset();
+        m_fp = open(time);
+    }
+    m_period_start = period_start(time);
+    m_next_rotation = next_rotation(time);
+    m_precreate_time = m_next_rotation - PrecreateLead;
+}
+
+} // namespace SlimLog
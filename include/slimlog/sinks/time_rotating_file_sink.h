@@ -0,0 +1,172 @@
+/**
+ * @file time_rotating_file_sink.h
+ * @brief Contains declaration of TimeRotatingFileSink class.
+ */
+
+#pragma once
+
+#include "slimlog/logger.h"
+#include "slimlog/sink.h"
+#include "slimlog/util/types.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace SlimLog {
+
+/**
+ * @brief Rotation period for time-based file sinks.
+ */
+enum class RotationPeriod : std::uint8_t {
+    Hourly, ///< Start a new file at the beginning of every hour.
+    Daily ///< Start a new file at local midnight.
+};
+
+/**
+ * @brief Output file-based sink rotated on wall-clock boundaries.
+ *
+ * This sink writes formatted log messages to a file which is switched every hour or day.
+ * Rotation is driven by the record time (RecordTime::local), so detecting a boundary
+ * costs a comparison against precomputed timestamps. The next file is created
+ * shortly before the boundary, so the switch itself is just a pointer swap.
+ *
+ * The periods follow the clock policy of the logger (see Logger): the first file is
+ * opened for the period of the first record, and a record from an earlier period
+ * (e.g. after ManualClock::set() into the past) switches back to the file of that period.
+ * Clocks not tied to the wall clock (e.g. MonotonicClock) give periods counted from
+ * their epoch, named as dates from 1970.
+ *
+ * File names are built from the base name by inserting the period timestamp before
+ * the extension, e.g. `app.log` becomes `app_2024-05-17_13.log` for hourly rotation
+ * and `app_2024-05-17.log` for daily rotation.
+ *
+ * @tparam String String type for log messages.
+ * @tparam Char Character type for the string.
+ * @tparam BufferSize Size of the internal pre-allocated buffer.
+ * @tparam Allocator Allocator type for the internal buffer.
+ */
+template<
+    typename String,
+    typename Char = Util::Types::UnderlyingCharType<String>,
+    std::size_t BufferSize = DefaultBufferSize,
+    typename Allocator = std::allocator<Char>>
+class TimeRotatingFileSink : public FormattableSink<String, Char, BufferSize, Allocator> {
+public:
+    using typename FormattableSink<String, Char, BufferSize, Allocator>::RecordType;
+    using typename FormattableSink<String, Char, BufferSize, Allocator>::FormatBufferType;
+
+    /** @brief How long before the boundary the next file is created. */
+    static constexpr std::chrono::seconds PrecreateLead{5};
+
+    /**
+     * @brief Constructs a new TimeRotatingFileSink object.
+     *
+     * The file is opened by the first record, for the period of the record time.
+     *
+     * @tparam Args Argument types for the pattern and log levels.
+     * @param filename Base log file name.
+     * @param period Rotation period.
+     * @param args Optional pattern and list of log levels.
+     */
+    template<typename... Args>
+    explicit TimeRotatingFileSink(
+        std::string_view filename, RotationPeriod period = RotationPeriod::Daily, Args&&... args)
+        : FormattableSink<String, Char, BufferSize, Allocator>(std::forward<Args>(args)...)
+        , m_period(period)
+    {
+        init(filename);
+    }
+
+    /**
+     * @brief Processes a log record.
+     *
+     * Formats the log record, switches the file if the record crossed
+     * the rotation boundary and writes the message to the current file.
+     *
+     * @param record The log record to process.
+     */
+    auto message(RecordType& record) -> void override;
+
+    /**
+     * @brief Flushes the current file.
+     */
+    auto flush() -> void override;
+
+protected:
+    /**
+     * @brief Builds the log file name for the period containing the specified time.
+     *
+     * @param time Local time within the period.
+     * @return Log file name.
+     */
+    [[nodiscard]] auto file_name(std::chrono::sys_seconds time) const -> std::string;
+
+    /**
+     * @brief Calculates the beginning of the period containing the specified time.
+     *
+     * @param time Local time.
+     * @return Local time of the last rotation.
+     */
+    [[nodiscard]] auto period_start(std::chrono::sys_seconds time) const
+        -> std::chrono::sys_seconds;
+
+    /**
+     * @brief Calculates the beginning of the period following the specified time.
+     *
+     * @param time Local time.
+     * @return Local time of the next rotation.
+     */
+    [[nodiscard]] auto next_rotation(std::chrono::sys_seconds time) const
+        -> std::chrono::sys_seconds;
+
+private:
+    using FilePtr = std::unique_ptr<FILE, int (*)(FILE*)>;
+
+    /**
+     * @brief Splits the base file name.
+     *
+     * @param filename Base log file name.
+     */
+    auto init(std::string_view filename) -> void;
+
+    /**
+     * @brief Opens the log file for the period containing the specified time.
+     *
+     * @param time Local time within the period.
+     * @return Owning pointer to the opened file.
+     */
+    auto open(std::chrono::sys_seconds time) const -> FilePtr;
+
+    /**
+     * @brief Opens the first file, pre-creates the next file or switches files.
+     *
+     * Called only when the record time passes the pre-creation threshold
+     * or precedes the current period.
+     *
+     * @param time Record local time.
+     */
+    auto rotate(std::chrono::sys_seconds time) -> void;
+
+    RotationPeriod m_period;
+    std::string m_basename;
+    std::string m_extension;
+    // No period until the first record
+    std::chrono::sys_seconds m_period_start = std::chrono::sys_seconds::max();
+    std::chrono::sys_seconds m_next_rotation = std::chrono::sys_seconds::max();
+    std::chrono::sys_seconds m_precreate_time = std::chrono::sys_seconds::max();
+    FilePtr m_fp = {nullptr, nullptr};
+    FilePtr m_next_fp = {nullptr, nullptr};
+    std::mutex m_mutex;
+};
+} // namespace SlimLog
+
+#ifdef SLIMLOG_HEADER_ONLY
+#include "slimlog/sinks/time_rotating_file_sink-inl.h" // IWYU pragma: keep
+#endif
@@ -0,0 +1,258 @@
+/**
+ * @file tracing.h
+ * @brief Contains the Tracer class timing the stages of the logging pipeline.
+ */
+
+#pragma once
+
+#include "slimlog/util/histogram.h"
+#include "slimlog/util/os.h"
+#include "slimlog/util/thread_slots.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#ifdef SLIMLOG_TRACING
+#include <chrono>
+#include <thread>
+#endif
+
+namespace SlimLog {
+
+/**
+ * @brief Stage of the logging pipeline.
+ */
+enum class Stage : std::uint8_t {
+    LevelCheck, ///< Logger levels and sink filters, until the first sink accepts the record.
+    CreateRecord, ///< Record creation: thread ID and local time.
+    Format, ///< Formatting of the user message.
+    SinkFormat, ///< Formatting of the record by the sink pattern, per sink.
+    SinkWrite ///< Output of the formatted record by the sink, per sink.
+};
+
+/** @brief Stage tracing is compiled in (see `SLIMLOG_TRACING`). */
+#ifdef SLIMLOG_TRACING
+inline constexpr bool TracingEnabled = true;
+#else
+inline constexpr bool TracingEnabled = false;
+#endif
+
+/** @brief Number of the pipeline stages. */
+inline constexpr std::size_t StageCount = static_cast<std::size_t>(Stage::SinkWrite) + 1;
+
+/**
+ * @brief Gets the stage name.
+ *
+ * @param stage Pipeline stage.
+ * @return Stage name in snake case.
+ */
+constexpr auto stage_name(Stage stage) -> std::string_view
+{
+    constexpr std::array<std::string_view, StageCount> Names{
+        "level_check", "create_record", "format", "sink_format", "sink_write"};
+    return Names[static_cast<std::size_t>(stage)]; // NOLINT(*-constant-array-index)
+}
+
+/**
+ * @brief Pipeline stage timer.
+ *
+ * Times the stages of each log call with the cycle counter (`rdtsc` on x86,
+ * `cntvct_el0` on AArch64, the steady clock elsewhere) and aggregates the durations
+ * into a log-linear histogram per stage (see Util::Histogram). Each thread records
+ * into its own set of relaxed atomic buckets, so recording costs two counter reads
+ * and an uncontended increment, and snapshot() can merge the buckets at any time
+ * without stopping the logging threads.
+ *
+ * Compiled in only with `SLIMLOG_TRACING` (CMake option `ENABLE_TRACING`), otherwise
+ * all methods are no-op and snapshot() returns empty histograms.
+ *
+ * Usage example:
+ * ```cpp
+ * const auto stages = Log::Tracer::snapshot();
+ * for (std::size_t i = 0; i < Log::StageCount; ++i) {
+ *     std::cout << Log::stage_name(static_cast<Log::Stage>(i)) << ": p99 "
+ *               << stages[i].percentile(99.0) << " ns\n";
+ * }
+ * ```
+ */
+class Tracer final {
+public:
+    /** @brief Histogram of the stage durations. */
+    using HistogramType = Util::Histogram<>;
+
+    /**
+     * @brief Times the stage from the construction until the destruction.
+     */
+    class Scope final {
+    public:
+        /**
+         * @brief Starts the stage.
+         *
+         * @param stage Pipeline stage.
+         */
+        explicit Scope([[maybe_unused]] Stage stage) noexcept
+#ifdef SLIMLOG_TRACING
+            : m_stage(stage)
+            , m_start(now())
+#endif
+        {
+        }
+
+        Scope(const Scope&) = delete;
+        Scope(Scope&&) = delete;
+        auto operator=(const Scope&) -> Scope& = delete;
+        auto operator=(Scope&&) -> Scope& = delete;
+
+        /**
+         * @brief Records the stage duration.
+         */
+        ~Scope()
+        {
+#ifdef SLIMLOG_TRACING
+            record(m_stage, m_start);
+#endif
+        }
+
+#ifdef SLIMLOG_TRACING
+    private:
+        Stage m_stage;
+        std::uint64_t m_start;
+#endif
+    };
+
+    /**
+     * @brief Reads the cycle counter.
+     *
+     * @return Counter ticks, zero if tracing is disabled.
+     */
+    [[nodiscard]] static auto now() noexcept -> std::uint64_t
+    {
+#ifdef SLIMLOG_TRACING
+        return Util::OS::cycle_counter();
+#else
+        return 0;
+#endif
+    }
+
+    /**
+     * @brief Records the stage which started at the given counter value and ends now.
+     *
+     * @param stage Pipeline stage.
+     * @param start Counter value at the start of the stage (see now()).
+     */
+    static auto record([[maybe_unused]] Stage stage, [[maybe_unused]] std::uint64_t start) noexcept
+        -> void
+    {
+#ifdef SLIMLOG_TRACING
+        const auto ticks = now() - start;
+        auto& bucket = local().buckets[static_cast<std::size_t>(stage)] // NOLINT(*-array-index)
+                                      [HistogramType::index(ticks)];
+        // Single writer: no read-modify-write needed
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+#endif
+    }
+
+    /**
+     * @brief Merges the stage histograms of all threads.
+     *
+     * Each value is the upper bound of its bucket converted to nanoseconds.
+     *
+     * @return Histograms of the stage durations in nanoseconds, indexed by Stage.
+     */
+    [[nodiscard]] static auto snapshot() -> std::array<HistogramType, StageCount>
+    {
+        std::array<HistogramType, StageCount> result;
+#ifdef SLIMLOG_TRACING
+        const auto scale = ticks_per_ns();
+        Util::ThreadSlots<ThreadData>::for_each([&result, scale](const ThreadData& data) {
+            for (std::size_t stage = 0; stage < StageCount; ++stage) {
+                // NOLINTNEXTLINE(*-constant-array-index)
+                const auto& buckets = data.buckets[stage];
+                for (std::size_t i = 0; i < HistogramType::BucketCount; ++i) {
+                    // NOLINTNEXTLINE(*-constant-array-index)
+                    if (const auto count = buckets[i].load(std::memory_order_relaxed)) {
+                        const auto ticks = static_cast<double>(HistogramType::upper_bound(i));
+                        // NOLINTNEXTLINE(*-constant-array-index)
+                        result[stage].record(static_cast<std::uint64_t>(ticks / scale), count);
+                    }
+                }
+            }
+        });
+#endif
+        return result;
+    }
+
+    /**
+     * @brief Clears the stage histograms of all threads.
+     *
+     * Samples recorded concurrently with the reset may be lost.
+     */
+    static auto reset() -> void
+    {
+#ifdef SLIMLOG_TRACING
+        Util::ThreadSlots<ThreadData>::for_each([](ThreadData& data) {
+            for (auto& buckets : data.buckets) {
+                for (auto& bucket : buckets) {
+                    bucket.store(0, std::memory_order_relaxed);
+                }
+            }
+        });
+#endif
+    }
+
+    /**
+     * @brief Gets the cycle counter frequency.
+     *
+     * Calibrated against the steady clock on the first call, which takes about 10 ms.
+     *
+     * @return Counter ticks per nanosecond.
+     */
+    [[nodiscard]] static auto ticks_per_ns() -> double
+    {
+#ifdef SLIMLOG_TRACING
+        static const double ticks_per_ns = []() {
+            using Clock = std::chrono::steady_clock;
+            constexpr std::chrono::milliseconds Duration{10};
+            const auto clock_start = Clock::now();
+            const auto ticks_start = now();
+            std::this_thread::sleep_for(Duration);
+            const auto ticks = static_cast<double>(now() - ticks_start);
+            const std::chrono::duration<double, std::nano> elapsed = Clock::now() - clock_start;
+            return ticks > 0 ? ticks / elapsed.count() : 1.0;
+        }();
+        return ticks_per_ns;
+#else
+        return 1.0;
+#endif
+    }
+
+#ifdef SLIMLOG_TRACING
+private:
+    /**
+     * @brief Stage buckets of a thread.
+     */
+    struct ThreadData {
+        /** @brief Bucket counts per stage, written by the owning thread only. */
+        std::array<std::array<std::atomic<std::uint64_t>, HistogramType::BucketCount>, StageCount>
+            buckets = {};
+    };
+
+    /**
+     * @brief Gets the buckets of the calling thread.
+     *
+     * The buckets of an exited thread are taken over with their counts,
+     * as the histograms are aggregated anyway.
+     *
+     * @return Buckets reference.
+     */
+    static auto local() noexcept -> ThreadData&
+    {
+        return Util::ThreadSlots<ThreadData>::local();
+    }
+#endif
+};
+
+} // namespace SlimLog
@@ -402,6 +402,16 @@ public:
         return m_allocator;
     }
 
+    /**
+     * @brief Checks if the buffer has outgrown the inline storage.
+     *
+     * @return \b true if the elements are stored in the allocated memory.
+     */
+    [[nodiscard]] constexpr auto heap_allocated() const noexcept -> bool
+    {
+        return this->data() != static_cast<const T*>(m_store);
+    }
+
     /**
      * @brief Resizes the buffer to contain `count` elements.
      *
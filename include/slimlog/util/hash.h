@@ -0,0 +1,87 @@
+/**
+ * @file hash.h
+ * @brief Provides fast non-cryptographic hash functions.
+ */
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+
+namespace SlimLog::Util::Hash {
+
+/** @cond */
+namespace Detail {
+inline constexpr std::uint64_t Prime1 = 0x9E3779B185EBCA87ULL;
+inline constexpr std::uint64_t Prime2 = 0xC2B2AE3D27D4EB4FULL;
+inline constexpr std::uint64_t Prime3 = 0x165667B19E3779F9ULL;
+
+inline auto load64(const unsigned char* data) noexcept -> std::uint64_t
+{
+    std::uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+} // namespace Detail
+/** @endcond */
+
+/**
+ * @brief Computes a 64-bit hash of the data.
+ *
+ * Long inputs are consumed in 32-byte blocks by four independent lanes,
+ * which lets the compiler keep them in vector registers; the remaining
+ * words and bytes are mixed sequentially and the result is finalized with
+ * an avalanche step. The result depends on the byte order of the platform.
+ *
+ * @param data Pointer to the data.
+ * @param size Data size in bytes.
+ * @param seed Initial hash value.
+ * @return Hash value.
+ */
+[[nodiscard]] inline auto hash64(const void* data, std::size_t size, std::uint64_t seed = 0) noexcept
+    -> std::uint64_t
+{
+    using namespace Detail;
+    constexpr std::size_t LaneCount = 4;
+    constexpr std::size_t BlockSize = LaneCount * sizeof(std::uint64_t);
+
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    std::uint64_t hash = seed ^ (size * Prime1);
+    std::size_t pos = 0;
+
+    if (size >= BlockSize) {
+        std::array<std::uint64_t, LaneCount> lanes{
+            hash + Prime1 + Prime2, hash + Prime2, hash, hash - Prime1};
+        for (; pos + BlockSize <= size; pos += BlockSize) {
+            for (std::size_t i = 0; i < LaneCount; ++i) {
+                const auto word = load64(std::next(bytes, pos + (i * sizeof(std::uint64_t))));
+                lanes[i] = std::rotl(lanes[i] + (word * Prime2), 31) * Prime1;
+            }
+        }
+        hash = std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12)
+            + std::rotl(lanes[3], 18);
+    }
+
+    for (; pos + sizeof(std::uint64_t) <= size; pos += sizeof(std::uint64_t)) {
+        hash = std::rotl(hash ^ (load64(std::next(bytes, pos)) * Prime2), 27) * Prime1;
+    }
+
+    if (pos < size) {
+        std::uint64_t tail = 0;
+        std::memcpy(&tail, std::next(bytes, pos), size - pos);
+        hash = std::rotl(hash ^ (tail * Prime1), 23) * Prime2;
+    }
+
+    hash ^= hash >> 33U;
+    hash *= Prime2;
+    hash ^= hash >> 29U;
+    hash *= Prime3;
+    hash ^= hash >> 32U;
+    return hash;
+}
+
+} // namespace SlimLog::Util::Hash
@@ -0,0 +1,187 @@
+/**
+ * @file histogram.h
+ * @brief Provides a log-linear histogram for latency measurements.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace SlimLog::Util {
+
+/**
+ * @brief Log-linear histogram of unsigned integer values.
+ *
+ * Follows the HdrHistogram layout: each power of two range is split into
+ * the same number of linear sub-buckets, so the relative error of a recorded value
+ * is bounded by `2^-(SubBucketBits - 1)` over the whole 64-bit range, while the
+ * storage stays fixed and small. Values below `2^SubBucketBits` are recorded exactly.
+ *
+ * Recording is a couple of bit operations and an increment. The histogram is not
+ * synchronized: keep one histogram per thread and merge them afterwards.
+ *
+ * Usage example:
+ * ```cpp
+ * Util::Histogram<> histogram;
+ * histogram.record(latency);
+ * auto p99 = histogram.percentile(99.0);
+ * ```
+ *
+ * @tparam SubBucketBits Number of bits of the linear sub-bucket index (precision).
+ */
+template<unsigned SubBucketBits = 6>
+class Histogram final {
+    static_assert(SubBucketBits >= 1 && SubBucketBits < 32, "Unsupported precision");
+
+public:
+    /** @brief Number of the buckets covering the 64-bit range. */
+    static constexpr std::size_t BucketCount
+        = ((std::numeric_limits<std::uint64_t>::digits - SubBucketBits) << (SubBucketBits - 1))
+        + (std::size_t{1} << SubBucketBits);
+
+    /**
+     * @brief Records the value.
+     *
+     * @param value Value to record.
+     * @param count Number of occurrences of the value.
+     */
+    constexpr auto record(std::uint64_t value, std::uint64_t count = 1) noexcept -> void
+    {
+        m_counts[index(value)] += count; // NOLINT(*-constant-array-index)
+        m_total += count;
+        m_min = std::min(m_min, value);
+        m_max = std::max(m_max, value);
+    }
+
+    /**
+     * @brief Adds the values recorded by another histogram.
+     *
+     * @param other Histogram to merge.
+     */
+    constexpr auto merge(const Histogram& other) noexcept -> void
+    {
+        for (std::size_t i = 0; i < BucketCount; ++i) {
+            m_counts[i] += other.m_counts[i]; // NOLINT(*-constant-array-index)
+        }
+        m_total += other.m_total;
+        m_min = std::min(m_min, other.m_min);
+        m_max = std::max(m_max, other.m_max);
+    }
+
+    /**
+     * @brief Removes all recorded values.
+     */
+    constexpr auto reset() noexcept -> void
+    {
+        *this = Histogram{};
+    }
+
+    /**
+     * @brief Gets the number of recorded values.
+     *
+     * @return Number of recorded values.
+     */
+    [[nodiscard]] constexpr auto count() const noexcept -> std::uint64_t
+    {
+        return m_total;
+    }
+
+    /**
+     * @brief Gets the smallest recorded value.
+     *
+     * @return Smallest value or zero if nothing has been recorded.
+     */
+    [[nodiscard]] constexpr auto min() const noexcept -> std::uint64_t
+    {
+        return m_total == 0 ? 0 : m_min;
+    }
+
+    /**
+     * @brief Gets the largest recorded value.
+     *
+     * @return Largest value or zero if nothing has been recorded.
+     */
+    [[nodiscard]] constexpr auto max() const noexcept -> std::uint64_t
+    {
+        return m_max;
+    }
+
+    /**
+     * @brief Gets the value below or at which the given percentage of values fall.
+     *
+     * The result is the upper bound of the bucket, clamped to the recorded range.
+     *
+     * @param percent Percentage in range `[0, 100]`.
+     * @return Percentile value or zero if nothing has been recorded.
+     */
+    [[nodiscard]] constexpr auto percentile(double percent) const noexcept -> std::uint64_t
+    {
+        if (m_total == 0) {
+            return 0;
+        }
+        const auto rank = std::max<std::uint64_t>(
+            1,
+            static_cast<std::uint64_t>(
+                std::ceil(std::clamp(percent, 0.0, 100.0) / 100.0 * static_cast<double>(m_total))));
+
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < BucketCount; ++i) {
+            seen += m_counts[i]; // NOLINT(*-constant-array-index)
+            if (seen >= rank) {
+                return std::clamp(upper_bound(i), min(), m_max);
+            }
+        }
+        return m_max;
+    }
+
+    /**
+     * @brief Gets the bucket index of the value.
+     *
+     * Allows keeping the bucket counts in another storage (e.g. atomic counters)
+     * and recording them later with the upper_bound() of the bucket.
+     *
+     * @param value Value.
+     * @return Bucket index in range `[0, BucketCount)`.
+     */
+    [[nodiscard]] static constexpr auto index(std::uint64_t value) noexcept -> std::size_t
+    {
+        // Values below 2^SubBucketBits have shift 0 and map to themselves, larger
+        // values keep their top SubBucketBits bits
+        const auto width = static_cast<unsigned>(std::bit_width(value));
+        const auto shift = width > SubBucketBits ? width - SubBucketBits : 0U;
+        return (static_cast<std::size_t>(shift) << (SubBucketBits - 1))
+            + static_cast<std::size_t>(value >> shift);
+    }
+
+    /**
+     * @brief Gets the largest value mapped to the bucket.
+     *
+     * @param index Bucket index.
+     * @return Largest value of the bucket.
+     */
+    [[nodiscard]] static constexpr auto upper_bound(std::size_t index) noexcept -> std::uint64_t
+    {
+        constexpr std::size_t Linear = std::size_t{1} << SubBucketBits;
+        if (index < Linear) {
+            return index;
+        }
+        const auto shift = (index >> (SubBucketBits - 1)) - 1;
+        const auto sub_bucket = index - (shift << (SubBucketBits - 1));
+        const auto lower = static_cast<std::uint64_t>(sub_bucket) << shift;
+        return lower + ((std::uint64_t{1} << shift) - 1);
+    }
+
+private:
+    std::array<std::uint64_t, BucketCount> m_counts = {};
+    std::uint64_t m_total = 0;
+    std::uint64_t m_min = std::numeric_limits<std::uint64_t>::max();
+    std::uint64_t m_max = 0;
+};
+
+} // namespace SlimLog::Util
@@ -11,6 +11,7 @@
 #endif
 
 #include <chrono>
+#include <cstdint>
 #include <ctime>
 #include <tuple>
 #include <utility>
@@ -26,9 +27,13 @@
 #define WIN32_LEAN_AND_MEAN
 #endif
 #include <windows.h> // for GetCurrentThreadId
+#if defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h> // for __rdtsc
+#endif
 #else
 #include <unistd.h>
 #ifdef __linux__
+#include <linux/membarrier.h> // for MEMBARRIER_CMD_PRIVATE_EXPEDITED
 #include <sys/syscall.h> // use gettid() syscall under linux to get thread id
 #elif defined(_AIX)
 #include <pthread.h> // for pthread_getthrds_np
@@ -42,6 +47,9 @@
 #include <AvailabilityMacros.h> // for MAC_OS_X_VERSION_MAX_ALLOWED
 #include <pthread.h> // for pthread_threadid_np
 #endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h> // for __rdtsc
+#endif
 #endif
 
 namespace SlimLog::Util::OS {
@@ -115,48 +123,129 @@ namespace SlimLog::Util::OS {
 }
 
 /**
- * @brief Gets the local time and nanoseconds component.
+ * @brief Reads the CPU cycle counter.
  *
- * Fetches the current local time, along with the additional nanoseconds,
- * providing higher resolution time data.
+ * Uses the time stamp counter on x86 and the virtual counter on AArch64, which tick
+ * at a constant rate on the modern CPUs. Falls back to the steady clock in nanoseconds
+ * on other architectures. The read is not serializing, so it may be reordered
+ * with the neighbouring instructions.
  *
- * @tparam TimePoint The type used to represent the time point (e.g., `std::tm`).
- * @return A pair consisting of the local time and the nanoseconds part.
+ * @return Counter ticks since an unspecified point.
  */
-[[nodiscard]] inline auto local_time() -> std::pair<std::chrono::sys_seconds, std::size_t>
+[[nodiscard]] inline auto cycle_counter() noexcept -> std::uint64_t
 {
-    static thread_local std::chrono::sys_seconds cached_local;
-    static thread_local std::time_t cached_time;
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    std::uint64_t ticks = 0;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                          std::chrono::steady_clock::now().time_since_epoch())
+                                          .count());
+#endif
+}
 
-    std::timespec curtime{};
+/**
+ * @brief Checks if process_barrier() is supported.
+ *
+ * Registers the process for the expedited `membarrier()` system call on the first call.
+ * Supported on Linux 4.14 and newer only.
+ *
+ * @return \b true if process_barrier() can be used.
+ */
+[[nodiscard]] inline auto process_barrier_supported() noexcept -> bool
+{
 #ifdef __linux__
-    std::ignore = ::clock_gettime(CLOCK_REALTIME_COARSE, &curtime);
+    constexpr int Command = MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED;
+    static const bool supported = ::syscall(SYS_membarrier, Command, 0, 0) == 0; // NOLINT(*-vararg)
+    return supported;
 #else
-    std::ignore = std::timespec_get(&curtime, TIME_UTC);
+    return false;
 #endif
+}
 
-    if (curtime.tv_sec != cached_time) {
-        cached_time = curtime.tv_sec;
+/**
+ * @brief Executes a full memory barrier on all running threads of the process.
+ *
+ * Lets the threads synchronizing with the caller use compiler fences only,
+ * has to be used only if process_barrier_supported() returns \b true.
+ */
+inline auto process_barrier() noexcept -> void
+{
+#ifdef __linux__
+    constexpr int Command = MEMBARRIER_CMD_PRIVATE_EXPEDITED;
+    std::ignore = ::syscall(SYS_membarrier, Command, 0, 0); // NOLINT(*-vararg)
+#endif
+}
 
-        std::tm local_tm{};
+/**
+ * @brief Converts the calendar time to the local time zone.
+ *
+ * @param time Seconds since the Unix epoch.
+ * @return Local time (the wall clock reading of the local time zone).
+ */
+[[nodiscard]] inline auto to_local(std::time_t time) -> std::chrono::sys_seconds
+{
+    std::tm local_tm{};
 #ifdef _WIN32
 #ifdef __STDC_WANT_SECURE_LIB__
-        std::ignore = ::localtime_s(&local_tm, &cached_time);
+    std::ignore = ::localtime_s(&local_tm, &time);
 #else
-        // MSVC is known to use thread-local buffer
-        local_tm = *std::localtime(&cached_time);
+    // MSVC is known to use thread-local buffer
+    local_tm = *std::localtime(&time);
 #endif
 #else
-        std::ignore = ::localtime_r(&cached_time, &local_tm);
+    std::ignore = ::localtime_r(&time, &local_tm);
 #endif
 
-        constexpr int TmEpoch = 1900;
-        cached_local = std::chrono::sys_days(std::chrono::year_month_day(
-                           std::chrono::year(local_tm.tm_year + TmEpoch),
-                           std::chrono::month(local_tm.tm_mon),
-                           std::chrono::day(local_tm.tm_mday)))
-            + std::chrono::hours(local_tm.tm_hour) + std::chrono::minutes(local_tm.tm_min)
-            + std::chrono::seconds(local_tm.tm_sec);
+    constexpr int TmEpoch = 1900;
+    return std::chrono::sys_days(std::chrono::year_month_day(
+               std::chrono::year(local_tm.tm_year + TmEpoch),
+               std::chrono::month(local_tm.tm_mon + 1),
+               std::chrono::day(local_tm.tm_mday)))
+        + std::chrono::hours(local_tm.tm_hour) + std::chrono::minutes(local_tm.tm_min)
+        + std::chrono::seconds(local_tm.tm_sec);
+}
+
+/**
+ * @brief Reads the real-time clock cheaply.
+ *
+ * Uses the coarse clock on Linux, which is read without a system call
+ * and has the resolution of the scheduler tick.
+ *
+ * @return Seconds and nanoseconds since the Unix epoch.
+ */
+[[nodiscard]] inline auto coarse_time() noexcept -> std::timespec
+{
+    std::timespec curtime{};
+#ifdef __linux__
+    std::ignore = ::clock_gettime(CLOCK_REALTIME_COARSE, &curtime);
+#else
+    std::ignore = std::timespec_get(&curtime, TIME_UTC);
+#endif
+    return curtime;
+}
+
+/**
+ * @brief Gets the local time and nanoseconds component.
+ *
+ * Fetches the current local time, along with the additional nanoseconds,
+ * providing higher resolution time data.
+ *
+ * @tparam TimePoint The type used to represent the time point (e.g., `std::tm`).
+ * @return A pair consisting of the local time and the nanoseconds part.
+ */
+[[nodiscard]] inline auto local_time() -> std::pair<std::chrono::sys_seconds, std::size_t>
+{
+    static thread_local std::chrono::sys_seconds cached_local;
+    static thread_local std::time_t cached_time;
+
+    const auto curtime = coarse_time();
+    if (curtime.tv_sec != cached_time) {
+        cached_time = curtime.tv_sec;
+        cached_local = to_local(cached_time);
     }
 
     return std::make_pair(cached_local, static_cast<std::size_t>(curtime.tv_nsec));
@@ -0,0 +1,322 @@
+/**
+ * @file rcu.h
+ * @brief Provides a pointer with read-copy-update semantics.
+ */
+
+#pragma once
+
+#include "slimlog/metrics.h"
+#include "slimlog/util/os.h"
+#include "slimlog/util/thread_slots.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace SlimLog::Util {
+
+/**
+ * @brief Read sections of all threads, shared by all RcuPointer objects.
+ *
+ * Each thread owns a reader slot on its own cache line. Entering the outermost read
+ * section stores the current global epoch into the slot, leaving it stores zero,
+ * so readers write only their own slot and never bounce a cache line between them.
+ * A writer advances the global epoch after publishing a new object and waits until
+ * no slot holds an older epoch: the readers which could have seen the previous object
+ * are gone then, while the readers which entered later do not hold the writer back.
+ * Where the system can force a memory barrier on all threads of the process
+ * (see OS::process_barrier()), the writer does so and the readers use no fence at all.
+ */
+class RcuDomain final {
+public:
+    /**
+     * @brief Reader slot of a thread.
+     */
+    struct alignas(SlimLog::Detail::CacheLineSize) Reader {
+        std::atomic<std::uint64_t> epoch = 0; ///< Epoch of the read section, zero if none.
+        std::size_t depth = 0; ///< Nesting depth of the read sections, owner thread only.
+    };
+
+    /**
+     * @brief Enters the read section of the calling thread.
+     *
+     * @return Reader slot of the calling thread.
+     */
+    static auto enter() noexcept -> Reader&
+    {
+        auto& reader = ThreadSlots<Reader>::local();
+        if (reader.depth++ == 0) {
+            // Acquire pairs with synchronize(): a reader of the new epoch sees the new object
+            reader.epoch.store(epoch().load(std::memory_order_acquire), std::memory_order_relaxed);
+            // Either the writer sees the slot or the reader sees the new object
+            if (OS::process_barrier_supported()) {
+                std::atomic_signal_fence(std::memory_order_seq_cst);
+            } else {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            }
+        }
+        return reader;
+    }
+
+    /**
+     * @brief Leaves the read section of the calling thread.
+     *
+     * @param reader Reader slot returned by enter().
+     */
+    static auto leave(Reader& reader) noexcept -> void
+    {
+        if (--reader.depth == 0) {
+            reader.epoch.store(0, std::memory_order_release);
+        }
+    }
+
+    /**
+     * @brief Waits for the readers which could have seen the objects replaced before the call.
+     *
+     * The read section of the calling thread, if any, is not waited for.
+     */
+    static auto synchronize() -> void
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto target = epoch().fetch_add(1, std::memory_order_acq_rel) + 1;
+        // Pairs with the fence of the readers in enter()
+        if (OS::process_barrier_supported()) {
+            OS::process_barrier();
+        } else {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+
+        const auto* self = &ThreadSlots<Reader>::local();
+        ThreadSlots<Reader>::for_each([self, target](const Reader& reader) {
+            if (&reader == self) {
+                return;
+            }
+            for (;;) {
+                const auto value = reader.epoch.load(std::memory_order_acquire);
+                if (value == 0 || value >= target) {
+                    break;
+                }
+                std::this_thread::yield();
+            }
+        });
+    }
+
+private:
+    /**
+     * @brief Gets the global epoch.
+     *
+     * @return Epoch reference, starts at one as zero marks an idle slot.
+     */
+    static auto epoch() noexcept -> std::atomic<std::uint64_t>&
+    {
+        static std::atomic<std::uint64_t> epoch = 1;
+        return epoch;
+    }
+};
+
+/**
+ * @brief Pointer to an object replaced with read-copy-update.
+ *
+ * Readers get the current object without locks and without writing shared memory:
+ * entering the read section stores the global epoch into the reader slot of the thread
+ * (see RcuDomain). Writers build a new object off to the side, publish it with one atomic
+ * pointer swap and destroy the old object after a grace period, when the readers which
+ * could have seen it are gone. Readers entering after the swap do not extend the grace
+ * period, so it ends even under continuous reading.
+ *
+ * A thread must not update the pointer while holding a ReadGuard of it.
+ *
+ * @tparam T Object type.
+ */
+template<typename T>
+class RcuPointer final {
+public:
+    /**
+     * @brief Read section guard.
+     *
+     * Keeps the object alive until the guard is destroyed.
+     */
+    class ReadGuard final {
+    public:
+        /**
+         * @brief Enters the read section.
+         *
+         * @param owner Pointer to read.
+         */
+        explicit ReadGuard(const RcuPointer& owner) noexcept
+            : m_reader(RcuDomain::enter())
+            , m_value(owner.m_value.load(std::memory_order_acquire))
+        {
+        }
+
+        ReadGuard(ReadGuard const&) = delete;
+        ReadGuard(ReadGuard&&) = delete;
+        auto operator=(ReadGuard const&) -> ReadGuard& = delete;
+        auto operator=(ReadGuard&&) -> ReadGuard& = delete;
+
+        /** @brief Leaves the read section. */
+        ~ReadGuard()
+        {
+            RcuDomain::leave(m_reader);
+        }
+
+        /**
+         * @brief Gets the object.
+         *
+         * @return Pointer to the object, may be null if the RcuPointer holds none.
+         */
+        [[nodiscard]] auto get() const noexcept -> T*
+        {
+            return m_value;
+        }
+
+        /**
+         * @brief Accesses the object.
+         *
+         * @return Pointer to the object.
+         */
+        auto operator->() const noexcept -> T*
+        {
+            return m_value;
+        }
+
+        /**
+         * @brief Accesses the object.
+         *
+         * @return Reference to the object.
+         */
+        auto operator*() const noexcept -> T&
+        {
+            return *m_value;
+        }
+
+    private:
+        RcuDomain::Reader& m_reader;
+        T* m_value;
+    };
+
+    /**
+     * @brief Constructs a new RcuPointer object.
+     *
+     * @param value Initial object.
+     */
+    explicit RcuPointer(std::unique_ptr<T> value)
+        : m_value(value.release())
+    {
+    }
+
+    RcuPointer(RcuPointer const&) = delete;
+    RcuPointer(RcuPointer&&) = delete;
+    auto operator=(RcuPointer const&) -> RcuPointer& = delete;
+    auto operator=(RcuPointer&&) -> RcuPointer& = delete;
+
+    /** @brief Destroys the RcuPointer object and the current object. */
+    ~RcuPointer()
+    {
+        const std::unique_ptr<T> value{m_value.load(std::memory_order_relaxed)};
+    }
+
+    /**
+     * @brief Enters the read section.
+     *
+     * @return Guard providing access to the current object.
+     */
+    [[nodiscard]] auto read() const noexcept -> ReadGuard
+    {
+        return ReadGuard(*this);
+    }
+
+    /**
+     * @brief Checks if there is no object without entering the read section.
+     *
+     * @return \b true if the pointer holds no object.
+     */
+    [[nodiscard]] auto empty() const noexcept -> bool
+    {
+        return m_value.load(std::memory_order_relaxed) == nullptr;
+    }
+
+    /**
+     * @brief Replaces the object.
+     *
+     * Waits for the readers of the previous object to finish before destroying it.
+     *
+     * @param value New object.
+     */
+    auto update(std::unique_ptr<T> value) -> void
+    {
+        const std::lock_guard lock(m_mutex);
+        publish(std::move(value));
+    }
+
+    /**
+     * @brief Replaces the object and takes the previous one.
+     *
+     * Waits for the readers of the previous object to finish before returning it.
+     *
+     * @param value New object.
+     * @return Previous object.
+     */
+    auto exchange(std::unique_ptr<T> value) -> std::unique_ptr<T>
+    {
+        const std::lock_guard lock(m_mutex);
+        return publish(std::move(value));
+    }
+
+    /**
+     * @brief Swaps the objects of two pointers without waiting for a grace period.
+     *
+     * Only valid if neither pointer has concurrent readers (e.g., when moving the owner).
+     *
+     * @param other Pointer to swap with.
+     */
+    auto swap(RcuPointer& other) noexcept -> void
+    {
+        other.m_value.store(
+            m_value.exchange(
+                other.m_value.load(std::memory_order_relaxed), std::memory_order_acq_rel),
+            std::memory_order_release);
+    }
+
+    /**
+     * @brief Replaces the object with the modified copy of the current one.
+     *
+     * Concurrent modifications are serialized, so none of them is lost.
+     *
+     * @tparam Func Invocable type accepting the object reference.
+     * @param func Function modifying the copy.
+     */
+    template<typename Func>
+    auto modify(Func&& func) -> void
+    {
+        const std::lock_guard lock(m_mutex);
+        auto value = std::make_unique<T>(*m_value.load(std::memory_order_relaxed));
+        std::forward<Func>(func)(*value);
+        publish(std::move(value));
+    }
+
+private:
+    /**
+     * @brief Publishes the object and waits for a grace period.
+     *
+     * Has to be called with the mutex locked.
+     *
+     * @param value New object.
+     * @return Previous object, no longer used by the readers.
+     */
+    auto publish(std::unique_ptr<T> value) -> std::unique_ptr<T>
+    {
+        std::unique_ptr<T> previous{m_value.exchange(value.release(), std::memory_order_seq_cst)};
+        RcuDomain::synchronize();
+        return previous;
+    }
+
+    std::atomic<T*> m_value;
+    std::mutex m_mutex;
+};
+
+} // namespace SlimLog::Util
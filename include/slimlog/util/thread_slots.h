@@ -0,0 +1,130 @@
+/**
+ * @file thread_slots.h
+ * @brief Provides per-thread slots which can be visited from any thread.
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace SlimLog::Util {
+
+/**
+ * @brief Per-thread slots of the process.
+ *
+ * Each thread gets a slot of its own on the first local() call and writes it without
+ * locking. The slots are never freed: the slot of an exited thread is handed over to
+ * the next new thread, so the number of slots is bounded by the peak number of threads
+ * and for_each() may visit the slots at any time.
+ *
+ * @tparam T Slot type.
+ */
+template<typename T>
+class ThreadSlots final {
+public:
+    /**
+     * @brief Gets the slot of the calling thread.
+     *
+     * @return Slot reference.
+     */
+    static auto local() noexcept -> T&
+    {
+        static thread_local const Handle handle;
+        return handle.slot->value;
+    }
+
+    /**
+     * @brief Calls the function for the slots of all threads, including the exited ones.
+     *
+     * No slots are added during the call, so the function must not call local()
+     * for the first time in the calling thread.
+     *
+     * @tparam Func Invocable type accepting the slot reference.
+     * @param func Function to call.
+     */
+    template<typename Func>
+    static auto for_each(Func&& func) -> void
+    {
+        auto& registry = ThreadSlots::registry();
+        const std::lock_guard lock(registry.mutex);
+        for (const auto& slot : registry.slots) {
+            func(slot->value);
+        }
+    }
+
+private:
+    /**
+     * @brief Slot with the ownership flag.
+     */
+    struct Slot {
+        T value = {}; ///< Slot contents.
+        bool in_use = true; ///< Slot is owned by a running thread.
+    };
+
+    /**
+     * @brief Slots of all threads.
+     */
+    struct Registry {
+        std::mutex mutex; ///< Protects the list.
+        std::vector<std::unique_ptr<Slot>> slots; ///< Slots, kept after thread exit.
+    };
+
+    /**
+     * @brief Releases the slot for reuse on thread exit.
+     */
+    struct Handle {
+        Slot* slot; ///< Slot of the thread.
+
+        Handle()
+            : slot(acquire())
+        {
+        }
+
+        Handle(const Handle&) = delete;
+        Handle(Handle&&) = delete;
+        auto operator=(const Handle&) -> Handle& = delete;
+        auto operator=(Handle&&) -> Handle& = delete;
+
+        ~Handle()
+        {
+            auto& registry = ThreadSlots::registry();
+            const std::lock_guard lock(registry.mutex);
+            slot->in_use = false;
+        }
+    };
+
+    /**
+     * @brief Gets the registry of the slots.
+     *
+     * @return Registry reference.
+     */
+    static auto registry() -> Registry&
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    /**
+     * @brief Takes the slot of an exited thread or allocates a new one.
+     *
+     * The contents of the slot taken over are kept as is.
+     *
+     * @return Slot of the calling thread.
+     */
+    static auto acquire() -> Slot*
+    {
+        auto& registry = ThreadSlots::registry();
+        const std::lock_guard lock(registry.mutex);
+        for (const auto& slot : registry.slots) {
+            if (!slot->in_use) {
+                slot->in_use = true;
+                return slot.get();
+            }
+        }
+        return registry.slots.emplace_back(std::make_unique<Slot>()).get();
+    }
+};
+
+} // namespace SlimLog::Util
@@ -0,0 +1,223 @@
+/**
+ * @file decode.cpp
+ * @brief Converts binary log files written by BinaryFileSink to text.
+ *
+ * Usage: `slimlog-decode <file> [pattern]`
+ */
+
+#include "slimlog/level.h"
+#include "slimlog/record.h"
+#include "slimlog/sinks/binary_file_sink.h"
+#include "slimlog/sinks/ostream_sink.h"
+
+#include <chrono>
+#include <clocale>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cwchar>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr std::string_view DefaultPattern = "[{level}] {time} {category} {file}:{line} {message}";
+
+/**
+ * @brief Sequential little-endian reader of the binary log data.
+ */
+class Reader {
+public:
+    explicit Reader(std::vector<unsigned char> data)
+        : m_data(std::move(data))
+    {
+    }
+
+    [[nodiscard]] auto empty() const -> bool
+    {
+        return m_pos >= m_data.size();
+    }
+
+    template<typename T>
+    auto get(T& value) -> bool
+    {
+        if (m_data.size() - m_pos < sizeof(T)) {
+            return false;
+        }
+        constexpr unsigned ByteBits = 8;
+        std::uint64_t raw = 0;
+        for (std::size_t i = 0; i < sizeof(T); ++i) {
+            raw |= static_cast<std::uint64_t>(m_data[m_pos + i]) << (i * ByteBits);
+        }
+        value = static_cast<T>(raw);
+        m_pos += sizeof(T);
+        return true;
+    }
+
+    template<typename Size, typename Char>
+    auto get_string(std::basic_string<Char>& str) -> bool
+    {
+        Size size = 0;
+        if (!get(size) || m_data.size() - m_pos < size) {
+            return false;
+        }
+        str.resize(size / sizeof(Char));
+        std::memcpy(str.data(), std::next(m_data.data(), static_cast<std::ptrdiff_t>(m_pos)), size);
+        m_pos += size;
+        return true;
+    }
+
+private:
+    std::vector<unsigned char> m_data;
+    std::size_t m_pos = 0;
+};
+
+/**
+ * @brief Decodes all entries and writes them to the output stream.
+ *
+ * @tparam Char Character type of the log file.
+ * @param reader Reader positioned after the file header.
+ * @param out Output stream.
+ * @param pattern Pattern for the output records.
+ * @return `true` if the whole file was decoded, `false` if it is truncated or corrupted.
+ */
+template<typename Char>
+auto decode(Reader& reader, std::basic_ostream<Char>& out, std::basic_string_view<Char> pattern)
+    -> bool
+{
+    using Format = SlimLog::BinaryLogFormat;
+
+    struct CallSite {
+        std::size_t line = {};
+        std::string file;
+        std::string function;
+        std::basic_string<Char> category;
+    };
+
+    constexpr std::int64_t NsecInSec = 1000000000;
+
+    SlimLog::OStreamSink<std::basic_string_view<Char>> sink(out, pattern);
+    std::unordered_map<std::uint32_t, CallSite> sites;
+    std::basic_string<Char> message;
+
+    while (!reader.empty()) {
+        std::uint8_t entry = 0;
+        reader.get(entry);
+        switch (static_cast<Format::Entry>(entry)) {
+        case Format::Entry::CallSite: {
+            std::uint32_t id = 0;
+            std::uint32_t line = 0;
+            CallSite site;
+            if (!reader.get(id) || !reader.get(line)
+                || !reader.get_string<std::uint16_t>(site.file)
+                || !reader.get_string<std::uint16_t>(site.function)
+                || !reader.get_string<std::uint16_t>(site.category)) {
+                return false;
+            }
+            site.line = line;
+            sites.insert_or_assign(id, std::move(site));
+            break;
+        }
+        case Format::Entry::Record: {
+            std::uint8_t level = 0;
+            std::uint32_t id = 0;
+            std::uint64_t thread_id = 0;
+            std::int64_t timestamp = 0;
+            if (!reader.get(level) || !reader.get(id) || !reader.get(thread_id)
+                || !reader.get(timestamp) || !reader.get_string<std::uint32_t>(message)) {
+                return false;
+            }
+            const auto site = sites.find(id);
+            if (site == sites.end()) {
+                return false;
+            }
+
+            SlimLog::Record<Char, std::basic_string_view<Char>> record;
+            record.level = static_cast<SlimLog::Level>(level);
+            record.location = {
+                std::string_view{site->second.file},
+                std::string_view{site->second.function},
+                site->second.line};
+            record.category = std::basic_string_view<Char>{site->second.category};
+            record.thread_id = thread_id;
+            record.time.local
+                = std::chrono::sys_seconds(std::chrono::seconds(timestamp / NsecInSec));
+            record.time.nsec = static_cast<std::size_t>(timestamp % NsecInSec);
+            record.message
+                = SlimLog::RecordStringView<Char>(std::basic_string_view<Char>{message});
+            sink.message(record);
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+
+    sink.flush();
+    return true;
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+    const std::vector<std::string_view> args(argv, std::next(argv, argc));
+    if (args.size() < 2 || args.size() > 3) {
+        std::cerr << "Usage: " << args.front() << " <file> [pattern]\n";
+        return EXIT_FAILURE;
+    }
+    const auto pattern = args.size() > 2 ? args[2] : DefaultPattern;
+
+    std::ifstream file(std::string(args[1]), std::ios::binary);
+    if (!file) {
+        std::cerr << "Error opening " << args[1] << '\n';
+        return EXIT_FAILURE;
+    }
+    Reader reader({std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()});
+
+    std::uint32_t magic = 0;
+    std::uint16_t version = 0;
+    std::uint16_t char_size = 0;
+    if (!reader.get(magic) || !reader.get(version) || !reader.get(char_size)
+        || magic != SlimLog::BinaryLogFormat::Magic
+        || version != SlimLog::BinaryLogFormat::Version) {
+        std::cerr << "Not a binary log file: " << args[1] << '\n';
+        return EXIT_FAILURE;
+    }
+
+    try {
+        bool complete = false;
+        if (char_size == sizeof(char)) {
+            complete = decode<char>(reader, std::cout, pattern);
+        } else if (char_size == sizeof(wchar_t)) {
+            std::setlocale(LC_ALL, ""); // NOLINT(concurrency-mt-unsafe)
+            std::mbstate_t state = {};
+            const auto* src = pattern.data();
+            std::wstring wpattern(pattern.size(), L'\0');
+            const auto size = std::mbsrtowcs(wpattern.data(), &src, wpattern.size(), &state);
+            wpattern.resize(size == static_cast<std::size_t>(-1) ? 0 : size);
+            complete = decode<wchar_t>(reader, std::wcout, wpattern);
+        } else {
+            std::cerr << "Unsupported character size: " << char_size << '\n';
+            return EXIT_FAILURE;
+        }
+
+        if (!complete) {
+            std::cerr << "Truncated or corrupted log file: " << args[1] << '\n';
+            return EXIT_FAILURE;
+        }
+    } catch (const std::exception& ex) {
+        std::cerr << "Error decoding " << args[1] << ": " << ex.what() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -1,22 +1,44 @@
+#include "slimlog/category_filter.h"
+#include "slimlog/config.h"
 #include "slimlog/format.h"
 #include "slimlog/logger.h"
 #include "slimlog/pattern.h"
 #include "slimlog/policy.h"
 #include "slimlog/record.h"
+#include "slimlog/registry.h"
 #include "slimlog/sink.h"
+#include "slimlog/sinks/binary_file_sink.h"
+#include "slimlog/sinks/dedup_sink.h"
 #include "slimlog/sinks/file_sink.h"
 #include "slimlog/sinks/null_sink.h"
 #include "slimlog/sinks/ostream_sink.h"
+#include "slimlog/sinks/ring_buffer_sink.h"
+#include "slimlog/sinks/throttling_sink.h"
+#include "slimlog/sinks/time_rotating_file_sink.h"
+#ifdef SLIMLOG_ZLIB
+#include "slimlog/sinks/compressed_file_sink.h"
+#endif
 
 #ifndef SLIMLOG_HEADER_ONLY
 // IWYU pragma: begin_keep
+#include "slimlog/category_filter-inl.h"
+#include "slimlog/config-inl.h"
 #include "slimlog/format-inl.h"
 #include "slimlog/pattern-inl.h"
 #include "slimlog/record-inl.h"
+#include "slimlog/registry-inl.h"
 #include "slimlog/sink-inl.h"
+#include "slimlog/sinks/binary_file_sink-inl.h"
+#include "slimlog/sinks/dedup_sink-inl.h"
 #include "slimlog/sinks/file_sink-inl.h"
 #include "slimlog/sinks/null_sink-inl.h"
 #include "slimlog/sinks/ostream_sink-inl.h"
+#include "slimlog/sinks/ring_buffer_sink-inl.h"
+#include "slimlog/sinks/throttling_sink-inl.h"
+#include "slimlog/sinks/time_rotating_file_sink-inl.h"
+#ifdef SLIMLOG_ZLIB
+#include "slimlog/sinks/compressed_file_sink-inl.h"
+#endif
 // IWYU pragma: end_keep
 #endif
 
@@ -28,8 +50,21 @@ namespace SlimLog {
 // char
 template class SinkDriver<Logger<std::string_view>, SingleThreadedPolicy>;
 template class SinkDriver<Logger<std::string_view>, MultiThreadedPolicy>;
+template class Sink<std::string_view>;
+template class CategoryFilter<char>;
+template class Registry<Logger<std::string_view>>;
+template class Config<Logger<std::string_view>>;
+template class ConfigWatcher<Logger<std::string_view>>;
 template class FileSink<std::string_view>;
 template class OStreamSink<std::string_view>;
+template class TimeRotatingFileSink<std::string_view>;
+template class BinaryFileSink<std::string_view>;
+template class RingBufferSink<std::string_view>;
+template class ThrottlingSink<std::string_view>;
+template class DedupSink<std::string_view>;
+#ifdef SLIMLOG_ZLIB
+template class CompressedFileSink<std::string_view>;
+#endif
 template class NullSink<std::string_view>;
 template class RecordStringView<char>;
 template class Pattern<char>;
@@ -43,8 +78,21 @@ template class FormatValue<std::chrono::sys_seconds, char>;
 // wchar_t
 template class SinkDriver<Logger<std::wstring_view>, SingleThreadedPolicy>;
 template class SinkDriver<Logger<std::wstring_view>, MultiThreadedPolicy>;
+template class Sink<std::wstring_view>;
+template class CategoryFilter<wchar_t>;
+template class Registry<Logger<std::wstring_view>>;
+template class Config<Logger<std::wstring_view>>;
+template class ConfigWatcher<Logger<std::wstring_view>>;
 template class FileSink<std::wstring_view>;
 template class OStreamSink<std::wstring_view>;
+template class TimeRotatingFileSink<std::wstring_view>;
+template class BinaryFileSink<std::wstring_view>;
+template class RingBufferSink<std::wstring_view>;
+template class ThrottlingSink<std::wstring_view>;
+template class DedupSink<std::wstring_view>;
+#ifdef SLIMLOG_ZLIB
+template class CompressedFileSink<std::wstring_view>;
+#endif
 template class NullSink<std::wstring_view>;
 template class RecordStringView<wchar_t>;
 template class Pattern<wchar_t>;
@@ -59,8 +107,21 @@ template class FormatValue<std::chrono::sys_seconds, wchar_t>;
 #ifdef SLIMLOG_CHAR8_T
 template class SinkDriver<Logger<std::u8string_view>, SingleThreadedPolicy>;
 template class SinkDriver<Logger<std::u8string_view>, MultiThreadedPolicy>;
+template class Sink<std::u8string_view>;
+template class CategoryFilter<char8_t>;
+template class Registry<Logger<std::u8string_view>>;
+template class Config<Logger<std::u8string_view>>;
+template class ConfigWatcher<Logger<std::u8string_view>>;
 template class FileSink<std::u8string_view>;
 template class OStreamSink<std::u8string_view>;
+template class TimeRotatingFileSink<std::u8string_view>;
+template class BinaryFileSink<std::u8string_view>;
+template class RingBufferSink<std::u8string_view>;
+template class ThrottlingSink<std::u8string_view>;
+template class DedupSink<std::u8string_view>;
+#ifdef SLIMLOG_ZLIB
+template class CompressedFileSink<std::u8string_view>;
+#endif
 template class NullSink<std::u8string_view>;
 template class RecordStringView<char8_t>;
 template class Pattern<char8_t>;
@@ -72,8 +133,21 @@ template class CachedFormatter<std::chrono::sys_seconds, char8_t>;
 #ifdef SLIMLOG_CHAR16_T
 template class SinkDriver<Logger<std::u16string_view>, SingleThreadedPolicy>;
 template class SinkDriver<Logger<std::u16string_view>, MultiThreadedPolicy>;
+template class Sink<std::u16string_view>;
+template class CategoryFilter<char16_t>;
+template class Registry<Logger<std::u16string_view>>;
+template class Config<Logger<std::u16string_view>>;
+template class ConfigWatcher<Logger<std::u16string_view>>;
 template class FileSink<std::u16string_view>;
 template class OStreamSink<std::u16string_view>;
+template class TimeRotatingFileSink<std::u16string_view>;
+template class BinaryFileSink<std::u16string_view>;
+template class RingBufferSink<std::u16string_view>;
+template class ThrottlingSink<std::u16string_view>;
+template class DedupSink<std::u16string_view>;
+#ifdef SLIMLOG_ZLIB
+template class CompressedFileSink<std::u16string_view>;
+#endif
 template class NullSink<std::u16string_view>;
 template class RecordStringView<char16_t>;
 template class Pattern<char16_t>;
@@ -86,8 +160,20 @@ template class CachedFormatter<std::chrono::sys_seconds, char16_t>;
 template class SinkDriver<Logger<std::u32string_view>, SingleThreadedPolicy>;
 template class SinkDriver<Logger<std::u32string_view>, MultiThreadedPolicy>;
 template class Sink<std::u32string_view>;
+template class CategoryFilter<char32_t>;
+template class Registry<Logger<std::u32string_view>>;
+template class Config<Logger<std::u32string_view>>;
+template class ConfigWatcher<Logger<std::u32string_view>>;
 template class FileSink<std::u32string_view>;
 template class OStreamSink<std::u32string_view>;
+template class TimeRotatingFileSink<std::u32string_view>;
+template class BinaryFileSink<std::u32string_view>;
+template class RingBufferSink<std::u32string_view>;
+template class ThrottlingSink<std::u32string_view>;
+template class DedupSink<std::u32string_view>;
+#ifdef SLIMLOG_ZLIB
+template class CompressedFileSink<std::u32string_view>;
+#endif
 template class NullSink<std::u32string_view>;
 template class RecordStringView<char32_t>;
 template class Pattern<char32_t>;